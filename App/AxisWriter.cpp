@@ -0,0 +1,127 @@
+#include "AxisWriter.h"
+
+#include "BinaryAxisWriter.h"
+#include "JsonLinesAxisWriter.h"
+#include "TextAxisWriter.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+
+AxisWriter::AxisWriter(std::ostream &output, std::size_t buffer_size)
+    : output(output), buffer(std::max<std::size_t>(buffer_size, 64)) {}
+
+AxisWriter::~AxisWriter()
+{
+    drain();
+    output.flush();
+}
+
+void AxisWriter::write_axes(
+    std::string_view label, const Ray *axes, std::size_t count)
+{
+    format_axes(label, axes, count);
+    if (flush_each_record)
+        flush();
+}
+
+void AxisWriter::write_symmetry(std::string_view label, bool symmetric)
+{
+    format_symmetry(label, symmetric);
+    if (flush_each_record)
+        flush();
+}
+
+void AxisWriter::write_error(std::string_view label, std::string_view message)
+{
+    format_error(label, message);
+    if (flush_each_record)
+        flush();
+}
+
+void AxisWriter::end_batch()
+{
+    flush();
+}
+
+void AxisWriter::flush()
+{
+    drain();
+    output.flush();
+}
+
+void AxisWriter::put(std::string_view data)
+{
+    if (buffer.size() - size < data.size())
+    {
+        drain();
+        if (buffer.size() < data.size())
+        {
+            output.write(data.data(), data.size());
+            return;
+        }
+    }
+
+    std::memcpy(buffer.data() + size, data.data(), data.size());
+    size += data.size();
+}
+
+void AxisWriter::put(char c)
+{
+    if (size == buffer.size())
+        drain();
+
+    buffer[size++] = c;
+}
+
+void AxisWriter::put_number(double value)
+{
+    char text[32];
+    auto result = std::to_chars(text, text + sizeof(text), value);
+    put(std::string_view(text, result.ptr - text));
+}
+
+void AxisWriter::put_number(double value, int precision)
+{
+    char text[32];
+    auto result = std::to_chars(
+        text, text + sizeof(text), value, std::chars_format::general, precision);
+    put(std::string_view(text, result.ptr - text));
+}
+
+void AxisWriter::drain()
+{
+    if (size != 0)
+    {
+        output.write(buffer.data(), size);
+        size = 0;
+    }
+}
+
+OutputFormat parse_output_format(const std::string &name)
+{
+    if (name == "text")
+        return OutputFormat::Text;
+    if (name == "jsonl")
+        return OutputFormat::JsonLines;
+    if (name == "binary")
+        return OutputFormat::Binary;
+
+    throw std::invalid_argument("Unknown output format.");
+}
+
+std::unique_ptr<AxisWriter> make_axis_writer(
+    OutputFormat format, std::ostream &output, std::ostream &errors)
+{
+    switch (format)
+    {
+    case OutputFormat::JsonLines:
+        return std::make_unique<JsonLinesAxisWriter>(output);
+    case OutputFormat::Binary:
+        return std::make_unique<BinaryAxisWriter>(output);
+    case OutputFormat::Text:
+    default:
+        return std::make_unique<TextAxisWriter>(output, errors);
+    }
+}
@@ -0,0 +1,187 @@
+#pragma once
+
+#include "Ray.h"
+
+#include <cstddef>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @enum OutputFormat
+ * @brief Formats the axes of symmetry can be written in.
+ */
+enum class OutputFormat
+{
+    Text,      ///< Human-readable text, as printed by the console application.
+    JsonLines, ///< One JSON object per polygon.
+    Binary     ///< Packed native-endian records of the rays.
+};
+
+/**
+ * @class AxisWriter
+ * @brief Base class for the writers of axes of symmetry.
+ *        The records are collected in a large buffer, which is written to 
+ *        the output only when full, at the end of a batch or on request.
+ */
+class AxisWriter
+{
+public:
+    /**
+     * @brief Constructs a writer over an output stream.
+     * @param output The stream to write to.
+     * @param buffer_size Size of the output buffer in bytes.
+     */
+    explicit AxisWriter(std::ostream &output,
+                        std::size_t buffer_size = DEFAULT_BUFFER_SIZE);
+
+    AxisWriter(const AxisWriter &) = delete;
+    AxisWriter &operator=(const AxisWriter &) = delete;
+
+    /**
+     * @brief Flushes the remaining records.
+     */
+    virtual ~AxisWriter();
+
+    /**
+     * @brief Writes the axes of symmetry found for one polygon.
+     * @param label Name of the polygon, may be empty.
+     * @param axes Pointer to the first axis.
+     * @param count Number of axes, zero for a non-symmetric polygon.
+     */
+    void write_axes(std::string_view label, const Ray *axes, std::size_t count);
+
+    /**
+     * @brief Writes the axes of symmetry found for one polygon.
+     * @tparam Container Contiguous container of rays.
+     * @param label Name of the polygon, may be empty.
+     * @param axes The axes, empty for a non-symmetric polygon.
+     */
+    template <typename Container>
+    void write_axes(std::string_view label, const Container &axes)
+    {
+        write_axes(label, axes.data(), axes.size());
+    }
+
+    /**
+     * @brief Writes whether a polygon is symmetric, without its axes.
+     * @param label Name of the polygon, may be empty.
+     * @param symmetric True if the polygon has an axis of symmetry.
+     */
+    void write_symmetry(std::string_view label, bool symmetric);
+
+    /**
+     * @brief Writes the error that prevented processing a polygon.
+     * @param label Name of the polygon, may be empty.
+     * @param message The error message.
+     */
+    void write_error(std::string_view label, std::string_view message);
+
+    /**
+     * @brief Marks the end of a batch, flushing the buffered records.
+     */
+    void end_batch();
+
+    /**
+     * @brief Writes the buffered records to the output stream and 
+     *        flushes it.
+     */
+    void flush();
+
+    /**
+     * @brief Makes the writer flush after every record.
+     * @param value True to flush after every record.
+     */
+    void set_flush_each_record(bool value) { flush_each_record = value; }
+
+    static constexpr std::size_t DEFAULT_BUFFER_SIZE = 1 << 20; ///< 1 MiB.
+
+protected:
+    /**
+     * @brief Formats the axes of one polygon into the buffer.
+     */
+    virtual void format_axes(
+        std::string_view label, const Ray *axes, std::size_t count) = 0;
+
+    /**
+     * @brief Formats whether one polygon is symmetric into the buffer.
+     */
+    virtual void format_symmetry(std::string_view label, bool symmetric) = 0;
+
+    /**
+     * @brief Formats the error of one polygon into the buffer.
+     */
+    virtual void format_error(
+        std::string_view label, std::string_view message) = 0;
+
+    /**
+     * @brief Appends raw bytes to the buffer.
+     * @param data The bytes to append.
+     */
+    void put(std::string_view data);
+
+    /**
+     * @brief Appends a single character to the buffer.
+     * @param c The character to append.
+     */
+    void put(char c);
+
+    /**
+     * @brief Appends a number in the shortest form that reads back 
+     *        to the same value.
+     * @param value The number to append.
+     */
+    void put_number(double value);
+
+    /**
+     * @brief Appends a number with the given number of significant 
+     *        digits, as std::ostream does by default.
+     * @param value The number to append.
+     * @param precision Number of significant digits.
+     */
+    void put_number(double value, int precision);
+
+    /**
+     * @brief Appends the object representation of a trivially copyable 
+     *        value.
+     * @tparam T Type of the value.
+     * @param value The value to append.
+     */
+    template <typename T>
+    void put_raw(const T &value)
+    {
+        put(std::string_view(
+            reinterpret_cast<const char *>(&value), sizeof(value)));
+    }
+
+private:
+    /**
+     * @brief Writes the buffered bytes to the output stream.
+     */
+    void drain();
+
+    std::ostream &output;
+    std::vector<char> buffer;
+    std::size_t size = 0;
+    bool flush_each_record = false;
+};
+
+/**
+ * @brief Parses the name of an output format.
+ * @param name One of "text", "jsonl" or "binary".
+ * @return The output format.
+ * @throws std::invalid_argument if the name is unknown.
+ */
+OutputFormat parse_output_format(const std::string &name);
+
+/**
+ * @brief Creates a writer for the given format.
+ * @param format The output format.
+ * @param output The stream to write the records to.
+ * @param errors The stream for the error messages of the text format.
+ * @return The writer.
+ */
+std::unique_ptr<AxisWriter> make_axis_writer(
+    OutputFormat format, std::ostream &output, std::ostream &errors);
@@ -0,0 +1,271 @@
+#include "BatchAnalyzer.h"
+
+#include "ConvexPolygon.h"
+#include "ConvexityCheck.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+struct BatchAnalyzer::Split
+{
+    Split(const std::vector<Point> &points, Result &result)
+        : points(points), result(result) {}
+
+    const std::vector<Point> &points;
+    Result &result;
+
+    std::atomic<std::size_t> remaining{0}; ///< Chunks of the current stage.
+
+    std::atomic<bool> positive{false};
+    std::atomic<bool> non_positive{false};
+    std::atomic<bool> violation{false};
+    std::vector<Point> sums; ///< Vertex sums of every chunk.
+
+    std::optional<ConvexPolygon> polygon;
+    std::optional<Point> centroid;
+
+    std::mutex axes_mutex;
+    std::vector<std::pair<std::size_t, Ray>> axes; ///< Axes by candidate.
+
+    std::mutex error_mutex;
+    std::string error; ///< First error thrown by a chunk.
+
+    void fail(const std::exception &e)
+    {
+        std::lock_guard<std::mutex> lock(error_mutex);
+        if (error.empty())
+            error = e.what();
+    }
+};
+
+BatchAnalyzer::BatchAnalyzer(Options options)
+    : options(options), pool(options.threads)
+{
+    if (this->options.grain == 0)
+        this->options.grain = 1;
+}
+
+BatchAnalyzer::BatchAnalyzer() : BatchAnalyzer(Options()) {}
+
+std::vector<BatchAnalyzer::Result> BatchAnalyzer::analyze(
+    const std::vector<std::vector<Point>> &polygons)
+{
+    std::vector<Result> results(polygons.size());
+
+    // Consecutive small polygons are grouped into tasks of about
+    // grain vertices, so that a batch of triangles is not dominated
+    // by the cost of scheduling
+    std::size_t group_first = 0;
+    std::size_t group_vertices = 0;
+
+    auto submit_group = [&](std::size_t last)
+    {
+        if (group_first < last)
+        {
+            const auto *first_polygon = polygons.data() + group_first;
+            auto *first_result = results.data() + group_first;
+            const auto count = last - group_first;
+
+            pool.submit([this, first_polygon, first_result, count]
+            {
+                analyze_serially(first_polygon, first_result, count);
+            });
+        }
+        group_first = last;
+        group_vertices = 0;
+    };
+
+    for (std::size_t i = 0; i < polygons.size(); ++i)
+    {
+        // The axis search of a symmetric polygon verifies up to n 
+        // candidates in O(n) each, so only a polygon whose n^2 fits 
+        // in a grain is sure to stay within one task
+        const auto n = polygons[i].size();
+        if (n == 0 || n <= options.grain / n)
+        {
+            group_vertices += n;
+            if (group_vertices >= options.grain)
+                submit_group(i + 1);
+            continue;
+        }
+
+        submit_group(i);
+        check_convexity_split(
+            std::make_shared<Split>(polygons[i], results[i]));
+        group_first = i + 1;
+    }
+    submit_group(polygons.size());
+
+    pool.wait();
+    return results;
+}
+
+void BatchAnalyzer::analyze_serially(
+    const std::vector<Point> *polygons, Result *results,
+    std::size_t count) const
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        try
+        {
+            ConvexPolygon polygon(polygons[i].begin(), polygons[i].end());
+            results[i].axes = polygon.find_axes_of_symmetry(options.EPS);
+        }
+        catch (const std::exception &e)
+        {
+            results[i].error = e.what();
+        }
+    }
+}
+
+void BatchAnalyzer::check_convexity_split(const std::shared_ptr<Split> &split)
+{
+    const auto n = split->points.size();
+    const auto chunks = (n + options.grain - 1) / options.grain;
+
+    split->sums.assign(chunks, Point(0, 0));
+    split->remaining.store(chunks, std::memory_order_relaxed);
+
+    for (std::size_t c = 0; c < chunks; ++c)
+    {
+        pool.submit([this, split, c, n]
+        {
+            const auto first = c * options.grain;
+            const auto last = std::min(first + options.grain, n);
+            const Point *points = split->points.data();
+
+            auto found = ConvexityCheck(points, n)
+                .turns(first, last, &split->violation);
+            if (found.positive)
+                split->positive.store(true, std::memory_order_relaxed);
+            if (found.non_positive)
+                split->non_positive.store(true, std::memory_order_relaxed);
+            if (found.mixed()
+                || (split->positive.load(std::memory_order_relaxed)
+                    && split->non_positive.load(std::memory_order_relaxed)))
+                split->violation.store(true, std::memory_order_relaxed);
+
+            // The centroid is summed in the same pass over the chunk
+            Point &sum = split->sums[c];
+            for (auto i = first; i < last; ++i)
+            {
+                sum.x += points[i].x;
+                sum.y += points[i].y;
+            }
+
+            if (split->remaining.fetch_sub(1, std::memory_order_acq_rel) != 1)
+                return;
+
+            if (split->positive.load() && split->non_positive.load())
+            {
+                split->result.error = "Points do not form a convex polygon.";
+                return;
+            }
+            find_axes_split(split);
+        });
+    }
+}
+
+void BatchAnalyzer::find_axes_split(const std::shared_ptr<Split> &split)
+{
+    const auto &points = split->points;
+    const auto n = points.size();
+
+    // The convexity is already checked, so the polygon is built
+    // without another validation
+    split->polygon.emplace(ConvexPolygon(ConvexPolygon::allocator_type()));
+    split->polygon->points.assign(points.begin(), points.end());
+
+    double x = 0;
+    double y = 0;
+    for (const auto &sum : split->sums)
+    {
+        x += sum.x;
+        y += sum.y;
+    }
+    split->centroid.emplace(x / n, y / n);
+
+    const auto candidates = split->polygon->candidate_count();
+    const auto chunks = (candidates + options.grain - 1) / options.grain;
+
+    split->remaining.store(chunks, std::memory_order_relaxed);
+
+    for (std::size_t c = 0; c < chunks; ++c)
+    {
+        const auto first = c * options.grain;
+        const auto last = std::min(first + options.grain, candidates);
+        pool.submit([this, split, first, last]
+        {
+            test_candidates(split, first, last);
+        });
+    }
+}
+
+void BatchAnalyzer::test_candidates(const std::shared_ptr<Split> &split,
+                                    std::size_t first, std::size_t last)
+{
+    std::vector<std::pair<std::size_t, Ray>> found;
+
+    try
+    {
+        std::size_t work = 0;
+        for (auto candidate = first; candidate < last; ++candidate)
+        {
+            std::size_t cost = 0;
+            auto axis = split->polygon->test_candidate(
+                candidate, *split->centroid, options.EPS, &cost);
+            if (axis)
+                found.emplace_back(candidate, *axis);
+
+            // Most candidates are pruned at the centroid, but those 
+            // that are verified cost O(n) each. Once a task has done 
+            // a grain of work, the upper half of the rest of its range 
+            // goes to another task, which idle workers can steal
+            work += cost;
+            if (work >= options.grain && last - candidate > 2)
+            {
+                const auto middle = candidate + 1 + (last - candidate - 1) / 2;
+                split->remaining.fetch_add(1, std::memory_order_relaxed);
+                pool.submit([this, split, middle, last]
+                {
+                    test_candidates(split, middle, last);
+                });
+                last = middle;
+                work = 0;
+            }
+        }
+    }
+    catch (const std::exception &e)
+    {
+        split->fail(e);
+    }
+
+    if (!found.empty())
+    {
+        std::lock_guard<std::mutex> lock(split->axes_mutex);
+        split->axes.insert(split->axes.end(), found.begin(), found.end());
+    }
+
+    if (split->remaining.fetch_sub(1, std::memory_order_acq_rel) != 1)
+        return;
+
+    if (!split->error.empty())
+    {
+        split->result.error = split->error;
+        return;
+    }
+
+    // The ranges finish in any order, so the axes are put back 
+    // in the order of the serial search
+    auto &axes = split->axes;
+    std::sort(axes.begin(), axes.end(), [](const auto &a, const auto &b)
+    {
+        return a.first < b.first;
+    });
+    for (const auto &[candidate, axis] : axes)
+        split->result.axes.push_back(axis);
+}
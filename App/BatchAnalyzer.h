@@ -0,0 +1,105 @@
+#pragma once
+
+#include "Point.h"
+#include "Ray.h"
+#include "WorkStealingPool.h"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @class BatchAnalyzer
+ * @brief Finds the axes of symmetry of a batch of polygons on a
+ *        work-stealing pool. Small polygons are grouped into tasks of
+ *        about the same amount of work. A polygon whose axis search may
+ *        cost more than a grain, which for a symmetric polygon grows as
+ *        n^2, is split: first into chunks of the convexity check, then
+ *        into ranges of candidate axes that halve themselves once they
+ *        have done a grain of work. A few huge or highly symmetric
+ *        polygons then do not keep one thread busy while the others
+ *        are idle.
+ */
+class BatchAnalyzer
+{
+public:
+    static constexpr std::size_t DEFAULT_GRAIN = 1 << 14;
+
+    /**
+     * @struct Options
+     * @brief Threads and task sizes.
+     */
+    struct Options
+    {
+        std::size_t threads = 0; ///< Worker threads, 0 for one per core.
+        std::size_t grain = DEFAULT_GRAIN; ///< Vertex visits per task.
+        double EPS = EPS_DEFAULT; ///< Tolerance of the axis search.
+    };
+
+    /**
+     * @struct Result
+     * @brief Axes of one polygon, or the reason it has none.
+     */
+    struct Result
+    {
+        std::vector<Ray> axes; ///< Axes in the order of the serial search.
+        std::string error; ///< Empty if the polygon is valid.
+    };
+
+    /**
+     * @brief Starts the worker threads.
+     * @param options Threads and task sizes.
+     */
+    explicit BatchAnalyzer(Options options);
+
+    /**
+     * @brief Starts one worker thread per core.
+     */
+    BatchAnalyzer();
+
+    /**
+     * @brief Finds the axes of symmetry of every polygon of a batch.
+     * @param polygons The vertices of each polygon.
+     * @return One result per polygon, in the same order.
+     */
+    std::vector<Result> analyze(const std::vector<std::vector<Point>> &polygons);
+
+private:
+    /**
+     * @struct Split
+     * @brief State shared by the tasks of one large polygon.
+     */
+    struct Split;
+
+    /**
+     * @brief Analyzes polygons serially, within a single task.
+     */
+    void analyze_serially(const std::vector<Point> *polygons,
+                          Result *results, std::size_t count) const;
+
+    /**
+     * @brief Checks the convexity of a large polygon in chunk tasks,
+     *        continuing with find_axes_split() after the last one.
+     */
+    void check_convexity_split(const std::shared_ptr<Split> &split);
+
+    /**
+     * @brief Tests the candidate axes of a large convex polygon in chunk
+     *        tasks, collecting the axes after the last one.
+     */
+    void find_axes_split(const std::shared_ptr<Split> &split);
+
+    /**
+     * @brief Tests a range of candidate axes, handing half of the rest
+     *        of the range to a new task after every grain of work.
+     * @param split The polygon being searched.
+     * @param first First candidate of the range.
+     * @param last One past the last candidate of the range.
+     */
+    void test_candidates(const std::shared_ptr<Split> &split,
+                         std::size_t first, std::size_t last);
+
+    Options options;
+    WorkStealingPool pool;
+};
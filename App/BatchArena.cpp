@@ -0,0 +1,21 @@
+#include "BatchArena.h"
+
+BatchArena::BatchArena(std::size_t initial_size)
+    : buffer(new std::byte[initial_size]),
+      arena(buffer.get(), initial_size, std::pmr::new_delete_resource()) {}
+
+std::pmr::memory_resource *BatchArena::resource()
+{
+    return &arena;
+}
+
+void BatchArena::reset()
+{
+    arena.release();
+}
+
+BatchArena &BatchArena::this_thread()
+{
+    thread_local BatchArena instance;
+    return instance;
+}
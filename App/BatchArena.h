@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+
+/**
+ * @class BatchArena
+ * @brief Monotonic memory arena for the allocations of one batch.
+ *        Memory is released in bulk when the batch is finished.
+ */
+class BatchArena
+{
+public:
+    /**
+     * @brief Constructs an arena with a preallocated initial buffer.
+     * @param initial_size Size of the initial buffer in bytes.
+     */
+    explicit BatchArena(std::size_t initial_size = DEFAULT_INITIAL_SIZE);
+
+    BatchArena(const BatchArena &) = delete;
+    BatchArena &operator=(const BatchArena &) = delete;
+
+    /**
+     * @brief Returns the memory resource of the arena.
+     * @return The memory resource to allocate the batch data from.
+     */
+    std::pmr::memory_resource *resource();
+
+    /**
+     * @brief Releases all the memory allocated since the last reset.
+     *        No object allocated from the arena may be used afterwards.
+     */
+    void reset();
+
+    /**
+     * @brief Returns the arena of the calling thread.
+     * @return The thread-local arena.
+     */
+    static BatchArena &this_thread();
+
+    static constexpr std::size_t DEFAULT_INITIAL_SIZE = 1 << 20; ///< 1 MiB.
+
+private:
+    std::unique_ptr<std::byte[]> buffer; ///< Initial buffer of the arena.
+    std::pmr::monotonic_buffer_resource arena; ///< Bump allocator.
+};
@@ -0,0 +1,36 @@
+#include "BinaryAxisWriter.h"
+
+BinaryAxisWriter::BinaryAxisWriter(std::ostream &output)
+    : AxisWriter(output) {}
+
+void BinaryAxisWriter::format_axes(
+    std::string_view, const Ray *axes, std::size_t count)
+{
+    put_raw((std::uint32_t)count);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const Ray &axis = axes[i];
+        const double packed[4] = {
+            axis.start_point.x,
+            axis.start_point.y,
+            axis.start_point.x + axis.direction.x,
+            axis.start_point.y + axis.direction.y,
+        };
+        put_raw(packed);
+    }
+}
+
+void BinaryAxisWriter::format_symmetry(std::string_view, bool symmetric)
+{
+    put_raw(SYMMETRY_MARK);
+    put_raw((std::uint32_t)symmetric);
+}
+
+void BinaryAxisWriter::format_error(
+    std::string_view, std::string_view message)
+{
+    put_raw(ERROR_MARK);
+    put_raw((std::uint32_t)message.size());
+    put(message);
+}
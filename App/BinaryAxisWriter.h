@@ -0,0 +1,38 @@
+#pragma once
+
+#include "AxisWriter.h"
+
+#include <cstdint>
+
+/**
+ * @class BinaryAxisWriter
+ * @brief Writes packed native-endian records, one per polygon and in 
+ *        the order they were written. A record starts with a uint32 axis 
+ *        count followed by four doubles per axis: x1, y1, x2, y2.
+ *        An error record has the count ERROR_MARK followed by a uint32 
+ *        message length and the message bytes. A record telling only 
+ *        whether the polygon is symmetric has the count SYMMETRY_MARK 
+ *        followed by a uint32 of 1 or 0. Labels are not written.
+ */
+class BinaryAxisWriter : public AxisWriter
+{
+public:
+    /**
+     * @brief Constructs a writer over an output stream, which should be 
+     *        opened in binary mode.
+     * @param output The stream to write to.
+     */
+    explicit BinaryAxisWriter(std::ostream &output);
+
+    static constexpr std::uint32_t ERROR_MARK = 0xFFFFFFFF; ///< Error record.
+    static constexpr std::uint32_t SYMMETRY_MARK = 0xFFFFFFFE; ///< Symmetry flag.
+
+protected:
+    void format_axes(
+        std::string_view label, const Ray *axes, std::size_t count) override;
+
+    void format_symmetry(std::string_view label, bool symmetric) override;
+
+    void format_error(
+        std::string_view label, std::string_view message) override;
+};
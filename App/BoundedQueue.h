@@ -0,0 +1,289 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+/**
+ * @class BoundedQueue
+ * @brief Fixed-capacity lock-free multi-producer multi-consumer queue.
+ *        Each cell carries a sequence number telling whether it is ready 
+ *        to be written or read in the current lap over the ring buffer.
+ *        The blocking push and pop spin briefly, then sleep on a condition
+ *        variable until the other side makes progress.
+ * @tparam T Type of the queued values, must be default constructible.
+ */
+template <typename T>
+class BoundedQueue
+{
+public:
+    /**
+     * @brief Constructs an empty queue.
+     * @param capacity Minimal capacity, rounded up to a power of two.
+     */
+    explicit BoundedQueue(std::size_t capacity);
+
+    BoundedQueue(const BoundedQueue &) = delete;
+    BoundedQueue &operator=(const BoundedQueue &) = delete;
+
+    /**
+     * @brief Tries to append a value without waiting.
+     * @param value The value, moved from only on success.
+     * @return True if the value was queued, false if the queue is full.
+     */
+    bool try_push(T &value);
+
+    /**
+     * @brief Tries to take the oldest value without waiting.
+     * @param value Receives the value on success.
+     * @return True if a value was taken, false if the queue is empty.
+     */
+    bool try_pop(T &value);
+
+    /**
+     * @brief Appends a value, waiting while the queue is full.
+     * @param value The value to append.
+     */
+    void push(T value);
+
+    /**
+     * @brief Takes the oldest value, waiting while the queue is empty.
+     * @param value Receives the value on success.
+     * @return True if a value was taken, false if the queue is closed 
+     *         and drained.
+     */
+    bool pop(T &value);
+
+    /**
+     * @brief Marks that no more values will be pushed.
+     */
+    void close();
+
+private:
+    struct Cell
+    {
+        std::atomic<std::size_t> sequence;
+        T value;
+    };
+
+    /**
+     * @brief Appends a value without waking the sleeping poppers.
+     */
+    bool enqueue(T &value);
+
+    /**
+     * @brief Takes the oldest value without waking the sleeping pushers.
+     */
+    bool dequeue(T &value);
+
+    /**
+     * @brief Wakes a thread sleeping on a condition if there is one.
+     */
+    void wake(std::atomic<std::size_t> &sleepers,
+              std::condition_variable &condition);
+
+    /// Failed attempts before a blocking call goes to sleep.
+    static constexpr int SPIN_LIMIT = 64;
+
+    std::unique_ptr<Cell[]> cells;
+    std::size_t mask;
+
+    alignas(64) std::atomic<std::size_t> enqueue_pos{0};
+    alignas(64) std::atomic<std::size_t> dequeue_pos{0};
+    alignas(64) std::atomic<bool> closed{false};
+
+    std::mutex sleep_mutex;
+    std::condition_variable not_full;
+    std::condition_variable not_empty;
+    std::atomic<std::size_t> push_sleepers{0};
+    std::atomic<std::size_t> pop_sleepers{0};
+};
+
+template <typename T>
+BoundedQueue<T>::BoundedQueue(std::size_t capacity)
+{
+    std::size_t size = 2;
+    while (size < capacity)
+        size *= 2;
+
+    cells.reset(new Cell[size]);
+    mask = size - 1;
+
+    for (std::size_t i = 0; i < size; ++i)
+        cells[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+template <typename T>
+bool BoundedQueue<T>::try_push(T &value)
+{
+    if (!enqueue(value))
+        return false;
+
+    wake(pop_sleepers, not_empty);
+    return true;
+}
+
+template <typename T>
+bool BoundedQueue<T>::try_pop(T &value)
+{
+    if (!dequeue(value))
+        return false;
+
+    wake(push_sleepers, not_full);
+    return true;
+}
+
+template <typename T>
+bool BoundedQueue<T>::enqueue(T &value)
+{
+    std::size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        Cell &cell = cells[pos & mask];
+        std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        auto diff = (std::ptrdiff_t)sequence - (std::ptrdiff_t)pos;
+
+        if (diff == 0)
+        {
+            if (enqueue_pos.compare_exchange_weak(
+                    pos, pos + 1, std::memory_order_relaxed))
+            {
+                cell.value = std::move(value);
+                cell.sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        }
+        else if (diff < 0)
+        {
+            // The cell still holds a value from the previous lap
+            return false;
+        }
+        else
+        {
+            pos = enqueue_pos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+template <typename T>
+bool BoundedQueue<T>::dequeue(T &value)
+{
+    std::size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        Cell &cell = cells[pos & mask];
+        std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        auto diff = (std::ptrdiff_t)sequence - (std::ptrdiff_t)(pos + 1);
+
+        if (diff == 0)
+        {
+            if (dequeue_pos.compare_exchange_weak(
+                    pos, pos + 1, std::memory_order_relaxed))
+            {
+                value = std::move(cell.value);
+                cell.sequence.store(pos + mask + 1, std::memory_order_release);
+                return true;
+            }
+        }
+        else if (diff < 0)
+        {
+            // The cell has not been written in this lap yet
+            return false;
+        }
+        else
+        {
+            pos = dequeue_pos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+template <typename T>
+void BoundedQueue<T>::push(T value)
+{
+    for (int spin = 0; !enqueue(value); ++spin)
+    {
+        if (spin < SPIN_LIMIT)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleep_mutex);
+        push_sleepers.fetch_add(1);
+        // Pairs with the fence in wake(): either the popper sees this
+        // sleeper or the retry below sees the freed cell
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        not_full.wait(lock, [&] { return enqueue(value); });
+        push_sleepers.fetch_sub(1);
+        break;
+    }
+
+    wake(pop_sleepers, not_empty);
+}
+
+template <typename T>
+bool BoundedQueue<T>::pop(T &value)
+{
+    for (int spin = 0;; ++spin)
+    {
+        if (dequeue(value))
+            break;
+
+        if (closed.load(std::memory_order_acquire))
+        {
+            // Values pushed before closing are visible now
+            if (!dequeue(value))
+                return false;
+            break;
+        }
+
+        if (spin < SPIN_LIMIT)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleep_mutex);
+        pop_sleepers.fetch_add(1);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        bool taken = false;
+        not_empty.wait(lock, [&]
+        {
+            taken = dequeue(value);
+            return taken || closed.load(std::memory_order_acquire);
+        });
+        pop_sleepers.fetch_sub(1);
+
+        if (!taken && !dequeue(value))
+            return false;
+        break;
+    }
+
+    wake(push_sleepers, not_full);
+    return true;
+}
+
+template <typename T>
+void BoundedQueue<T>::close()
+{
+    closed.store(true, std::memory_order_release);
+
+    std::lock_guard<std::mutex> lock(sleep_mutex);
+    not_empty.notify_all();
+}
+
+template <typename T>
+void BoundedQueue<T>::wake(std::atomic<std::size_t> &sleepers,
+                           std::condition_variable &condition)
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleepers.load(std::memory_order_relaxed) == 0)
+        return;
+
+    // Taking the mutex orders the notification after the sleeper's check
+    std::lock_guard<std::mutex> lock(sleep_mutex);
+    condition.notify_one();
+}
@@ -1,163 +1,718 @@
 #include "ConvexPolygon.h"
 
+#include "ConvexityCheck.h"
+#include "TransformChain.h"
 #include "TransformMatrix.h"
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <limits>
 #include <stdexcept>
+#include <utility>
+
+ConvexPolygon::ConvexPolygon(
+    const ConvexPolygon &other, const allocator_type &alloc)
+    : points(other.points, alloc) {}
+
+ConvexPolygon::ConvexPolygon(
+    ConvexPolygon &&other, const allocator_type &alloc)
+    : points(std::move(other.points), alloc)
+{
+    // The vertices were either moved or copied, so the cached data 
+    // of the other polygon cannot be kept
+    other.cache = PolygonCache();
+}
+
+ConvexPolygon ConvexPolygon::transformed(const TransformChain &chain) const
+{
+    TransformMatrix m = chain.fold();
+
+    // A non-singular affine map keeps the polygon convex, 
+    // so the result does not need another validation
+    if (m.at(0, 0) * m.at(1, 1) - m.at(0, 1) * m.at(1, 0) == 0)
+    {
+        throw std::invalid_argument(
+            "Transformation is singular."
+        );
+    }
+
+    ConvexPolygon result(get_allocator());
+    result.points.assign(points.begin(), points.end());
+    chain.apply(result.points.data(), result.points.size());
+    return result;
+}
 
 bool ConvexPolygon::is_convex() const
 {
-    if (points.size() < 3) return false;
+    return ConvexityCheck(points.data(), points.size()).is_convex();
+}
+
+bool ConvexPolygon::is_convex_parallel() const
+{
+    return ConvexityCheck(points.data(), points.size()).is_convex_parallel();
+}
+
+std::vector<Ray> ConvexPolygon::find_axes_of_symmetry(double EPS) const
+{
+    if (const auto *found = cache.find_axes(EPS))
+        return std::vector<Ray>(found->begin(), found->end());
+
+    auto range = axes(EPS);
+    std::vector<Ray> result(range.begin(), range.end());
+    cache.store_axes(EPS, result.data(), result.size(),
+                     points.get_allocator().resource());
+    return result;
+}
+
+std::pmr::vector<Ray> ConvexPolygon::find_axes_of_symmetry(
+    std::pmr::memory_resource *resource, double EPS) const
+{
+    if (const auto *found = cache.find_axes(EPS))
+        return std::pmr::vector<Ray>(found->begin(), found->end(), resource);
+
+    auto range = axes(EPS);
+    std::pmr::vector<Ray> result(range.begin(), range.end(), resource);
+    cache.store_axes(EPS, result.data(), result.size(),
+                     points.get_allocator().resource());
+    return result;
+}
+
+std::pmr::vector<Ray> ConvexPolygon::find_axes_of_symmetry(
+    const ConvexPolygon &original, std::pmr::memory_resource *resource,
+    double EPS) const
+{
+    std::pmr::vector<Ray> result = find_axes_of_symmetry(resource, EPS);
+    const auto found = result.size();
 
-    bool sign = false;
-    for (size_t i = 0; i < points.size(); ++i)
+    // An axis that does not hold shows that the simplification broke 
+    // the symmetry, and possibly hid other axes, so the original 
+    // outline is searched instead
+    original.retain_axes(result, EPS);
+    if (result.size() != found)
+        return original.find_axes_of_symmetry(resource, EPS);
+
+    return result;
+}
+
+Point ConvexPolygon::centroid() const
+{
+    double x = 0;
+    double y = 0;
+    for (const auto &p : points)
     {
-        const Point &p0 = points[i];
-        const Point &p1 = points[(i + 1) % points.size()];
-        const Point &p2 = points[(i + 2) % points.size()];
+        x += p.x;
+        y += p.y;
+    }
+    return Point(x / points.size(), y / points.size());
+}
 
-        Vector v1 = p1 - p0;
-        Vector v2 = p2 - p1;
+ConvexPolygon::AxisRange ConvexPolygon::axes(double EPS) const
+{
+    return AxisRange(this, EPS);
+}
 
-        double cross_product = v1.cross_product(v2);
-        if (i == 0)
-        {
-            sign = cross_product > 0;
-        }
-        else if ((cross_product > 0) != sign)
-        {
-            return false;
-        }
+bool ConvexPolygon::has_symmetry(double EPS) const
+{
+    if (const auto *found = cache.find_axes(EPS))
+        return !found->empty();
+
+    auto range = axes(EPS);
+    return range.begin() != range.end();
+}
+
+bool ConvexPolygon::has_symmetry(
+    const ConvexPolygon &original, double EPS) const
+{
+    bool broken = false;
+    for (const Ray &axis : axes(EPS))
+    {
+        if (original.verify_axes(&axis, 1, EPS)[0])
+            return true;
+        broken = true;
     }
-    return true;
+
+    // An axis that does not hold shows that the simplification broke 
+    // the symmetry, so its missing axes say nothing about the original
+    return broken && original.has_symmetry(EPS);
 }
 
-std::vector<Ray> ConvexPolygon::find_axes_of_symmetry(double EPS) const
+std::size_t ConvexPolygon::count_axes(double EPS) const
 {
-    std::vector<Ray> result;
+    if (const auto *found = cache.find_axes(EPS))
+        return found->size();
 
-    const auto n = points.size();
-    const auto half_n = (n + 1) / 2;
+    const Point centroid = this->centroid();
+
+    std::size_t count = 0;
+    for (std::size_t c = 0; c < candidate_count(); ++c)
+    {
+        if (test_candidate(c, centroid, EPS))
+            ++count;
+    }
+    return count;
+}
 
-    auto get_midpoint =
-        [](const Point &a, const Point &b) -> Point
+ConvexPolygon::AxisIterator ConvexPolygon::AxisRange::begin() const
+{
+    return AxisIterator(polygon, 0, centroid, EPS);
+}
+
+ConvexPolygon::AxisIterator ConvexPolygon::AxisRange::end() const
+{
+    return AxisIterator(polygon, polygon->candidate_count(), centroid, EPS);
+}
+
+ConvexPolygon::AxisIterator::AxisIterator(
+    const ConvexPolygon *polygon, std::size_t candidate,
+    const Point &centroid, double EPS)
+    : polygon(polygon), candidate(candidate), centroid(centroid), EPS(EPS)
+{
+    find_axis();
+}
+
+ConvexPolygon::AxisIterator &ConvexPolygon::AxisIterator::operator++()
+{
+    ++candidate;
+    find_axis();
+    return *this;
+}
+
+ConvexPolygon::AxisIterator ConvexPolygon::AxisIterator::operator++(int)
+{
+    AxisIterator copy = *this;
+    ++*this;
+    return copy;
+}
+
+void ConvexPolygon::AxisIterator::find_axis()
+{
+    for (; candidate < polygon->candidate_count(); ++candidate)
+    {
+        axis = polygon->test_candidate(candidate, centroid, EPS);
+        if (axis)
+            return;
+    }
+    axis.reset();
+}
+
+namespace
+{
+    Point get_midpoint(const Point &a, const Point &b)
     {
         return Point(
             (a.x + b.x) / 2,
             (a.y + b.y) / 2);
-    };
+    }
 
-    auto is_axis_symmetric =
-        [&](Ray axis,
-            size_t index_of_next_point_in_forward_direction,
-            size_t index_of_next_point_in_reverse_direction) -> bool
+    bool same_entry(const PolygonCache::SignatureEntry &a,
+                    const PolygonCache::SignatureEntry &b, double EPS)
     {
-        auto axis_perpendicular_direction =
-            Vector(-axis.direction.y, axis.direction.x);
-
-        Ray axis2(
-            axis.start_point, axis_perpendicular_direction);
+        return std::abs(a.length - b.length) <= EPS
+            && std::abs(a.angle - b.angle) <= EPS;
+    }
 
-        auto axis_transform =
-            TransformMatrix(axis, axis2)
-            .inverse();
+    // The entries of a signature, bucketed by their cell in a grid 
+    // of spacing EPS. Entries within EPS of each other lie in the same 
+    // cell or in neighbouring ones. The cells are kept in an open 
+    // addressing table, and the entries of a cell in a linked list 
+    // threaded through one array, so building it allocates twice
+    class SignatureGrid
+    {
+    public:
+        SignatureGrid(
+            const std::pmr::vector<PolygonCache::SignatureEntry> &entries,
+            double EPS)
+            : EPS(EPS), next(entries.size())
+        {
+            std::size_t size = 1;
+            while (size < 2 * entries.size())
+                size *= 2;
+            slots.resize(size);
 
-        auto &fi = index_of_next_point_in_forward_direction;
-        auto &ri = index_of_next_point_in_reverse_direction;
+            for (std::size_t j = 0; j < entries.size(); ++j)
+            {
+                const auto [length, angle] = cell(entries[j]);
+                Slot &slot = find(length, angle);
+                if (slot.count == 0)
+                {
+                    slot.length = length;
+                    slot.angle = angle;
+                }
+                next[j] = slot.head;
+                slot.head = j;
+                ++slot.count;
+            }
+        }
 
-        for (size_t j = 0; j < half_n; ++j)
+        // Number of entries in the cells around the entry
+        std::size_t count_near(const PolygonCache::SignatureEntry &entry) const
         {
-            if (fi == n) fi -= n;
-            if (ri == (size_t)-1) ri = n - 1;
+            std::size_t count = 0;
+            for_each_cell_near(entry, [&](const Slot &slot)
+            {
+                count += slot.count;
+            });
+            return count;
+        }
 
-            if (fi != ri)
+        // Calls visit(j) for every entry j in the cells around the entry
+        template <typename Visit>
+        void for_each_near(const PolygonCache::SignatureEntry &entry,
+                           Visit visit) const
+        {
+            for_each_cell_near(entry, [&](const Slot &slot)
             {
-                auto ftp =
-                    // forward direction transformed point
-                    axis_transform * points[fi];
+                for (auto j = slot.head; j != NONE; j = next[j])
+                    visit(j);
+            });
+        }
+
+    private:
+        static constexpr std::size_t NONE = (std::size_t)-1;
+
+        struct Slot
+        {
+            long long length = 0;
+            long long angle = 0;
+            std::size_t head = NONE;
+            std::size_t count = 0; ///< 0 for an unused slot.
+        };
 
-                auto rtp =
-                    // reverse direction transformed point
-                    axis_transform * points[ri];
+        long long index(double value) const
+        {
+            const double spacing =
+                EPS > 0 ? EPS : std::numeric_limits<double>::denorm_min();
+            return (long long)std::clamp(std::floor(value / spacing),
+                                         -4e18, 4e18);
+        }
+
+        std::pair<long long, long long> cell(
+            const PolygonCache::SignatureEntry &entry) const
+        {
+            return {index(entry.length), index(entry.angle)};
+        }
+
+        // The slot of the cell, or the unused slot where it would go
+        const Slot &find(long long length, long long angle) const
+        {
+            std::uint64_t hash = (std::uint64_t)length * 0x9E3779B97F4A7C15ULL
+                ^ (std::uint64_t)angle * 0xC2B2AE3D27D4EB4FULL;
+            hash ^= hash >> 29;
 
-                if (std::abs(ftp.x - rtp.x) > EPS
-                    || std::abs(ftp.y) - std::abs(rtp.y) > EPS)
-                    return false;
+            const std::size_t mask = slots.size() - 1;
+            for (std::size_t i = hash & mask;; i = (i + 1) & mask)
+            {
+                const Slot &slot = slots[i];
+                if (slot.count == 0
+                    || (slot.length == length && slot.angle == angle))
+                    return slot;
             }
+        }
 
-            fi++;
-            ri--;
+        Slot &find(long long length, long long angle)
+        {
+            return const_cast<Slot &>(
+                std::as_const(*this).find(length, angle));
+        }
+
+        template <typename Visit>
+        void for_each_cell_near(const PolygonCache::SignatureEntry &entry,
+                                Visit visit) const
+        {
+            const auto [length, angle] = cell(entry);
+            for (long long dl = -1; dl <= 1; ++dl)
+            {
+                for (long long da = -1; da <= 1; ++da)
+                {
+                    const Slot &slot = find(length + dl, angle + da);
+                    if (slot.count > 0)
+                        visit(slot);
+                }
+            }
         }
 
-        return true;
+        double EPS;
+        std::vector<Slot> slots;
+        std::vector<std::size_t> next; ///< Next entry in the same cell.
     };
 
-    bool has_even_points_amount = n % 2 == 0;
+    // Search of the pattern in the text read cyclically; calls found(s), 
+    // in increasing order, for every shift s at which pattern[i] matches 
+    // text[(s + i) % n]. Matching within EPS is not transitive, so the 
+    // shifts cannot be found by string matching on the entries; instead 
+    // every shift pairing one pattern entry with a matching text entry 
+    // is checked in full. The entry with the fewest text entries in 
+    // its neighbouring cells is chosen, which leaves a few shifts 
+    // unless the signature is nearly regular
+    template <typename Found>
+    void find_cyclic_matches(
+        const std::vector<PolygonCache::SignatureEntry> &pattern,
+        const std::pmr::vector<PolygonCache::SignatureEntry> &text,
+        const SignatureGrid &grid, double EPS, Found found)
+    {
+        const auto n = pattern.size();
+
+        std::size_t anchor = 0;
+        std::size_t fewest = n + 1;
+        for (std::size_t i = 0; i < n && fewest > 1; ++i)
+        {
+            const auto count = grid.count_near(pattern[i]);
+            if (count < fewest)
+            {
+                fewest = count;
+                anchor = i;
+            }
+        }
+
+        std::vector<std::size_t> shifts;
+        grid.for_each_near(pattern[anchor], [&](std::size_t j)
+        {
+            if (same_entry(text[j], pattern[anchor], EPS))
+                shifts.push_back((j + n - anchor) % n);
+        });
+        std::sort(shifts.begin(), shifts.end());
+
+        for (auto shift : shifts)
+        {
+            std::size_t i = 0;
+            while (i < n && same_entry(pattern[i], text[(shift + i) % n], EPS))
+                ++i;
+            if (i == n)
+                found(shift);
+        }
+    }
+
+    // The affine map taking the triangle a onto the triangle b
+    TransformMatrix map_triangle(const Point (&a)[3], const Point (&b)[3])
+    {
+        TransformMatrix from(Ray(a[0], a[1] - a[0]), Ray(a[0], a[2] - a[0]));
+        TransformMatrix to(Ray(b[0], b[1] - b[0]), Ray(b[0], b[2] - b[0]));
+        return to * from.inverse();
+    }
+
+    // Distance of the point from the axis, measured in the axis frame 
+    // used by ConvexPolygon::is_axis_symmetric. The full check bounds 
+    // the sum of the signed distances of every pair of mirrored 
+    // vertices by EPS, and twice the distance of a vertex mirrored 
+    // onto itself. The vertex centroid of a polygon that passes is 
+    // then within EPS / 2 of the axis, so pruning at EPS never drops 
+    // an accepted axis
+    bool passes_near(const Ray &axis, const Point &point, double EPS)
+    {
+        const auto length_squared = 
+            axis.direction.dot_product(axis.direction);
+
+        return std::abs(axis.direction.cross_product(point - axis.start_point))
+            <= EPS * length_squared;
+    }
+
+    // Coordinates of p in the axis frame used by is_axis_symmetric, 
+    // measured in units of the axis direction d and scaled by |d|^2: 
+    // the position along the axis, and the signed distance from it
+    inline double frame_along(double dx, double dy, double sx, double sy,
+                              const Point &p)
+    {
+        return dx * (p.x - sx) + dy * (p.y - sy);
+    }
+
+    inline double frame_across(double dx, double dy, double sx, double sy,
+                               const Point &p)
+    {
+        return dx * (p.y - sy) - dy * (p.x - sx);
+    }
+
+    // Whether p and q are mirror images about the axis through s with 
+    // direction d, where bound is EPS * |d|^2: at the same position 
+    // along the axis, and at opposite distances from it. A vertex 
+    // mirrored onto itself must therefore lie on the axis
+    inline bool is_mirrored(const Vector &d, const Point &s, double bound,
+                            const Point &p, const Point &q)
+    {
+        return std::abs(frame_along(d.x, d.y, s.x, s.y, p)
+                        - frame_along(d.x, d.y, s.x, s.y, q)) <= bound
+            && std::abs(frame_across(d.x, d.y, s.x, s.y, p)
+                        + frame_across(d.x, d.y, s.x, s.y, q)) <= bound;
+    }
+}
+
+std::vector<TransformMatrix> ConvexPolygon::match(
+    const ConvexPolygon &other, double EPS) const
+{
+    std::vector<TransformMatrix> transforms;
+
+    const auto n = points.size();
+    if (n < 3 || other.points.size() != n)
+        return transforms;
+
+    const auto &signature = this->signature();
+    const auto &target = other.signature();
+    const auto &q = other.points;
+
+    // Traversed forwards, vertex i corresponds to vertex s + i
+    const SignatureGrid grid(target, EPS);
+
+    std::vector<PolygonCache::SignatureEntry> pattern(
+        signature.begin(), signature.end());
+    find_cyclic_matches(pattern, target, grid, EPS, [&](std::size_t s)
+    {
+        const Point a[3] = {points[0], points[1], points[2]};
+        const Point b[3] = {q[s], q[(s + 1) % n], q[(s + 2) % n]};
+        transforms.push_back(map_triangle(a, b));
+    });
+
+    // Traversed backwards, vertex n - i corresponds to vertex s + i, 
+    // which finds the matches that reverse the orientation
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        pattern[i] = {signature[(2 * n - i - 1) % n].length,
+                      signature[(n - i) % n].angle};
+    }
+    find_cyclic_matches(pattern, target, grid, EPS, [&](std::size_t s)
+    {
+        const Point a[3] = {points[0], points[n - 1], points[n - 2]};
+        const Point b[3] = {q[s], q[(s + 1) % n], q[(s + 2) % n]};
+        transforms.push_back(map_triangle(a, b));
+    });
+
+    return transforms;
+}
+
+std::vector<bool> ConvexPolygon::verify_axes(
+    const Ray *axes, std::size_t count, double EPS) const
+{
+    std::vector<bool> result(count);
+
+    for (std::size_t first = 0; first < count; first += VERIFY_BLOCK)
+    {
+        const auto block = std::min(VERIFY_BLOCK, count - first);
+
+        bool holds[VERIFY_BLOCK];
+        verify_axis_block(axes + first, block, EPS, holds);
+
+        for (std::size_t a = 0; a < block; ++a)
+            result[first + a] = holds[a];
+    }
+
+    return result;
+}
+
+void ConvexPolygon::verify_axis_block(
+    const Ray *axes, std::size_t count, double EPS, bool *holds) const
+{
+    const auto n = points.size();
+    const Point *p = points.data();
+
+    double dx[VERIFY_BLOCK], dy[VERIFY_BLOCK];
+    double sx[VERIFY_BLOCK], sy[VERIFY_BLOCK];
+    double bound[VERIFY_BLOCK];
+    std::size_t partner[VERIFY_BLOCK];
+
+    for (std::size_t a = 0; a < count; ++a)
+    {
+        const auto &d = axes[a].direction;
+        const auto &s = axes[a].start_point;
+        const double length_squared = d.dot_product(d);
+
+        dx[a] = d.x;
+        dy[a] = d.y;
+        sx[a] = s.x;
+        sy[a] = s.y;
+        bound[a] = EPS * length_squared;
+        partner[a] = 0;
+        holds[a] = length_squared > 0 && n > 0;
+    }
+
+    if (n == 0)
+        return;
+
+    // A reflection reverses the order of the vertices, so vertex j 
+    // must land on vertex m - j, where m is the vertex nearest to 
+    // the mirror image of vertex 0
+    for (std::size_t a = 0; a < count; ++a)
+    {
+        if (!holds[a])
+            continue;
+
+        const double along0 = frame_along(dx[a], dy[a], sx[a], sy[a], p[0]);
+        const double across0 = frame_across(dx[a], dy[a], sx[a], sy[a], p[0]);
 
-    for (size_t i = 0; i < half_n; ++i)
+        double nearest = INFINITY;
+        for (std::size_t j = 0; j < n; ++j)
+        {
+            const double along = 
+                frame_along(dx[a], dy[a], sx[a], sy[a], p[j]) - along0;
+            const double across = 
+                frame_across(dx[a], dy[a], sx[a], sy[a], p[j]) + across0;
+            const double distance = along * along + across * across;
+            if (distance < nearest)
+            {
+                nearest = distance;
+                partner[a] = j;
+            }
+        }
+    }
+
+    // Frame coordinates of a run of vertices and of the run they 
+    // should land on, in the same order
+    double along[VERIFY_TILE], across[VERIFY_TILE];
+    double mirrored_along[VERIFY_TILE], mirrored_across[VERIFY_TILE];
+
+    // Counts the vertices j in [begin, end) that are not the mirror 
+    // image of vertex offset - j. The mirrored vertices form a 
+    // contiguous run as well, so the loops need neither a modulo 
+    // nor a branch and vectorize
+    auto count_unmirrored = [&](std::size_t a, std::size_t begin,
+                                std::size_t end, std::size_t offset)
     {
-        auto io =
-            // index of a point that's
-            // assumed to be an opposite one
-            // if the polygon is symmetrical
-            i + half_n;
+        if (begin >= end)
+            return std::size_t(0);
+
+        const auto length = end - begin;
+        const Point *forward = p + begin;
+        const Point *mirrored = p + (offset + 1 - end);
+
+        for (std::size_t i = 0; i < length; ++i)
+        {
+            along[i] = frame_along(dx[a], dy[a], sx[a], sy[a], forward[i]);
+            across[i] = frame_across(dx[a], dy[a], sx[a], sy[a], forward[i]);
+            mirrored_along[i] = 
+                frame_along(dx[a], dy[a], sx[a], sy[a], mirrored[i]);
+            mirrored_across[i] = 
+                frame_across(dx[a], dy[a], sx[a], sy[a], mirrored[i]);
+        }
+
+        std::size_t failed = 0;
+        for (std::size_t i = 0; i < length; ++i)
+        {
+            const auto r = length - 1 - i;
+            failed += 
+                (std::abs(along[i] - mirrored_along[r]) > bound[a])
+                | (std::abs(across[i] + mirrored_across[r]) > bound[a]);
+        }
+        return failed;
+    };
+
+    // The vertices are checked in tiles shared by the whole block, 
+    // which stops early once no axis of the block holds
+    for (std::size_t first = 0; first < n; first += VERIFY_TILE)
+    {
+        const auto last = std::min(first + VERIFY_TILE, n);
+
+        bool any = false;
+        for (std::size_t a = 0; a < count; ++a)
+        {
+            if (!holds[a])
+                continue;
+
+            // Vertex j lands on m - j up to m, and on m + n - j after it
+            const auto m = partner[a];
+            holds[a] = 
+                count_unmirrored(a, first, std::min(last, m + 1), m) == 0
+                && count_unmirrored(a, std::max(first, m + 1), last, m + n)
+                   == 0;
+            any = any || holds[a];
+        }
+
+        if (!any)
+            return;
+    }
+}
+
+std::optional<Ray> ConvexPolygon::test_candidate(
+    std::size_t candidate, const Point &centroid, double EPS,
+    std::size_t *work) const
+{
+    const auto n = points.size();
+    const auto half_n = (n + 1) / 2;
+
+    // Each of the first half_n vertices yields two candidates: 
+    // an axis through the vertex and one through the midpoint 
+    // of the segment that follows it
+    const auto i = candidate / 2;
+    const bool through_midpoint = candidate % 2 == 1;
+
+    auto io =
+        // index of a point that's
+        // assumed to be an opposite one
+        // if the polygon is symmetrical
+        i + half_n;
+
+    const auto &p = points[i];
+    const auto &q = points[i + 1];
+    auto m = get_midpoint(p, q);
 
-        const auto &p = points[i];
-        const auto &q = points[i + 1];
-        auto m = get_midpoint(p, q);
+    bool has_even_points_amount = n % 2 == 0;
 
+    auto axis = [&]
+    {
         if (has_even_points_amount)
         {
             const auto &po = points[io];
             const auto &qo = points[(io + 1) % n];
             auto mo = get_midpoint(po, qo);
 
-            // Checking if symmetry lies through 
-            // the current point and opposite point
-            {
-                Ray axis(p, po - p);
+            // Checking if symmetry lies through the current point 
+            // and opposite point, or through the midpoint of the 
+            // current segment and opposite midpoint
+            return through_midpoint ? Ray(m, mo - m) : Ray(p, po - p);
+        }
 
-                if (is_axis_symmetric(axis, i + 1, i - 1))
-                    result.push_back(axis);
-            }
+        // With an odd amount of points, the last midpoint candidate 
+        // would repeat the axis through the first point, 
+        // so there is one candidate less than 2 * half_n
+        const auto &po = points[io % n];
+        const auto &qo = points[io - 1];
+        auto mo = get_midpoint(po, qo);
 
-            // Checking if symmetry lies through 
-            // the midpoint of the current segment, 
-            // and opposite midpoint
-            {
-                Ray axis(m, mo - m);
+        // Checking if symmetry lies through the current point 
+        // and opposite midpoint, or through the midpoint of the 
+        // current segment and opposite point
+        return through_midpoint ? Ray(m, po - m) : Ray(p, mo - p);
+    }();
 
-                if (is_axis_symmetric(axis, i + 1, i))
-                    result.push_back(axis);
-            }
-        }
-        else // !has_even_points_amount
-        {
-            const auto &po = points[io % n];
-            const auto &qo = points[io - 1];
-            auto mo = get_midpoint(po, qo);
+    if (work)
+        *work = 1;
 
-            // Checking if symmetry lies through 
-            // the current point and opposite midpoint
-            {
-                Ray axis(p, mo - p);
+    if (!passes_near(axis, centroid, EPS))
+        return std::nullopt;
 
-                if (is_axis_symmetric(axis, i + 1, i - 1))
-                    result.push_back(axis);
-            }
+    if (work)
+        *work = half_n;
 
-            // Checking if symmetry lies through 
-            // the midpoint of the current segment, 
-            // and opposite point
-            {
-                Ray axis(m, po - m);
+    // The vertices after the current one are paired with the ones 
+    // before the axis: before the vertex it goes through, or from 
+    // the start of the segment it crosses
+    if (!is_axis_symmetric(axis, i + 1, through_midpoint ? i : i - 1, EPS))
+        return std::nullopt;
 
-                if (is_axis_symmetric(axis, i + 1, i))
-                    result.push_back(axis);
-            }
-        }
+    return axis;
+}
+
+bool ConvexPolygon::is_axis_symmetric(
+    const Ray &axis, std::size_t forward, std::size_t reverse, double EPS) const
+{
+    const auto n = points.size();
+    const auto half_n = (n + 1) / 2;
+
+    const auto &d = axis.direction;
+    const auto &s = axis.start_point;
+    const double bound = EPS * d.dot_product(d);
+
+    auto &fi = forward;
+    auto &ri = reverse;
+
+    for (size_t j = 0; j < half_n; ++j)
+    {
+        if (fi == n) fi -= n;
+        if (ri == (size_t)-1) ri = n - 1;
+
+        if (fi != ri && !is_mirrored(d, s, bound, points[fi], points[ri]))
+            return false;
+
+        fi++;
+        ri--;
     }
 
-    return result;
+    return true;
 }
@@ -1,12 +1,22 @@
 #pragma once
 
 #include "Point.h"
+#include "PolygonCache.h"
 #include "Ray.h"
+#include "TransformMatrix.h"
+#include "VertexSimplifier.h"
 
+#include <cstddef>
+#include <execution>
 #include <iterator>
+#include <memory_resource>
+#include <optional>
 #include <stdexcept>
+#include <type_traits>
 #include <vector>
 
+class TransformChain;
+
 /**
  * @class ConvexPolygon
  * @brief Represents a convex polygon in 2D space.
@@ -14,15 +24,176 @@
 class ConvexPolygon
 {
 public:
+    using allocator_type = std::pmr::polymorphic_allocator<Point>;
+
+    class AxisRange;
+
+    /**
+     * @class AxisIterator
+     * @brief Input iterator over the axes of symmetry of a polygon. 
+     *        The next axis is searched for only when the iterator is 
+     *        incremented.
+     */
+    class AxisIterator
+    {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = Ray;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Ray *;
+        using reference = const Ray &;
+
+        reference operator*() const { return *axis; }
+        pointer operator->() const { return &*axis; }
+
+        /**
+         * @brief Advances to the next axis of symmetry.
+         * @return This iterator.
+         */
+        AxisIterator &operator++();
+
+        /**
+         * @brief Advances to the next axis of symmetry.
+         * @return A copy of this iterator before advancing.
+         */
+        AxisIterator operator++(int);
+
+        bool operator==(const AxisIterator &other) const
+        {
+            return candidate == other.candidate;
+        }
+
+        bool operator!=(const AxisIterator &other) const
+        {
+            return candidate != other.candidate;
+        }
+
+    private:
+        friend class AxisRange;
+
+        /**
+         * @brief Constructs an iterator at the first axis among the 
+         *        candidates starting from the given one.
+         */
+        AxisIterator(const ConvexPolygon *polygon, std::size_t candidate,
+                     const Point &centroid, double EPS);
+
+        /**
+         * @brief Moves to the first axis among the candidates starting 
+         *        from the current one.
+         */
+        void find_axis();
+
+        const ConvexPolygon *polygon;
+        std::size_t candidate; ///< Index of the current candidate axis.
+        Point centroid; ///< Vertex centroid used to prune candidates.
+        double EPS;
+        std::optional<Ray> axis; ///< The current axis.
+    };
+
+    /**
+     * @class AxisRange
+     * @brief Lazily evaluated range of the axes of symmetry of a polygon.
+     */
+    class AxisRange
+    {
+    public:
+        /**
+         * @brief Returns an iterator at the first axis of symmetry.
+         * @return The iterator.
+         */
+        AxisIterator begin() const;
+
+        /**
+         * @brief Returns the past-the-end iterator.
+         * @return The iterator.
+         */
+        AxisIterator end() const;
+
+    private:
+        friend class ConvexPolygon;
+
+        AxisRange(const ConvexPolygon *polygon, double EPS)
+            : polygon(polygon), centroid(polygon->centroid()), 
+              EPS(EPS) {}
+
+        const ConvexPolygon *polygon;
+        Point centroid; ///< Vertex centroid, computed once per range.
+        double EPS;
+    };
+
     /**
      * @brief Constructs a ConvexPolygon from a range of points.
      * @tparam InputIt Iterator type for the input points.
      * @param first Iterator to the first point.
      * @param last Iterator to the past-the-end point.
+     * @param alloc Allocator used for the vertex storage.
      * @throws std::invalid_argument if the points do not form a convex polygon.
      */
     template <typename InputIt>
-    ConvexPolygon(InputIt first, InputIt last);
+    ConvexPolygon(InputIt first, InputIt last,
+                  const allocator_type &alloc = {});
+
+    /**
+     * @brief Constructs a ConvexPolygon from a range of points, removing 
+     *        the redundant vertices before the validation.
+     * @tparam InputIt Iterator type for the input points.
+     * @param first Iterator to the first point.
+     * @param last Iterator to the past-the-end point.
+     * @param simplifier The simplification to apply to the points.
+     * @param alloc Allocator used for the vertex storage.
+     * @throws std::invalid_argument if the simplified points do not form 
+     *         a convex polygon.
+     */
+    template <typename InputIt>
+    ConvexPolygon(InputIt first, InputIt last,
+                  const VertexSimplifier &simplifier,
+                  const allocator_type &alloc = {});
+
+    /**
+     * @brief Constructs a ConvexPolygon from a range of points, checking 
+     *        the convexity according to an execution policy.
+     * @tparam ExecutionPolicy One of the std::execution policy types. 
+     *         Any policy but std::execution::seq checks large polygons 
+     *         in parallel chunks.
+     * @tparam InputIt Iterator type for the input points.
+     * @param policy The execution policy.
+     * @param first Iterator to the first point.
+     * @param last Iterator to the past-the-end point.
+     * @param alloc Allocator used for the vertex storage.
+     * @throws std::invalid_argument if the points do not form a convex polygon.
+     */
+    template <typename ExecutionPolicy, typename InputIt,
+              typename = std::enable_if_t<std::is_execution_policy_v<
+                  std::decay_t<ExecutionPolicy>>>>
+    ConvexPolygon(ExecutionPolicy &&policy, InputIt first, InputIt last,
+                  const allocator_type &alloc = {});
+
+    ConvexPolygon(const ConvexPolygon &other) = default;
+    ConvexPolygon(ConvexPolygon &&other) = default;
+
+    /**
+     * @brief Copies a polygon into storage obtained from the given allocator.
+     * @param other The polygon to copy.
+     * @param alloc Allocator used for the vertex storage.
+     */
+    ConvexPolygon(const ConvexPolygon &other, const allocator_type &alloc);
+
+    /**
+     * @brief Moves a polygon into storage obtained from the given allocator.
+     * @param other The polygon to move.
+     * @param alloc Allocator used for the vertex storage.
+     */
+    ConvexPolygon(ConvexPolygon &&other, const allocator_type &alloc);
+
+    ConvexPolygon &operator=(const ConvexPolygon &other) = default;
+    ConvexPolygon &operator=(ConvexPolygon &&other) = default;
+
+    /**
+     * @brief Returns the allocator used for the vertex storage.
+     * @return The allocator of the points vector.
+     */
+    allocator_type get_allocator() const { return points.get_allocator(); }
 
     /**
      * @brief Returns an iterator to the beginning of the points vector.
@@ -37,24 +208,281 @@ public:
     auto end() const { return points.end(); }
 
     /**
-     * @brief Finds all axes of symmetry for the polygon.
+     * @brief Returns the edge vectors. Edge i goes from vertex i to 
+     *        vertex i + 1, the last one back to the first vertex.
+     *        Computed on first use, like the other derived properties.
+     * @return The edge vectors.
+     */
+    const std::pmr::vector<Vector> &edges() const
+    {
+        return geometry().edges;
+    }
+
+    /**
+     * @brief Returns the length of every edge with the turning angle at 
+     *        the vertex it starts from.
+     * @return One entry per edge, in the order of the edges.
+     */
+    const std::pmr::vector<PolygonCache::SignatureEntry> &signature() const
+    {
+        return geometry().signature;
+    }
+
+    /**
+     * @brief Returns the area of the polygon.
+     * @return The area.
+     */
+    double area() const { return geometry().area; }
+
+    /**
+     * @brief Returns the perimeter of the polygon.
+     * @return The sum of the edge lengths.
+     */
+    double perimeter() const { return geometry().perimeter; }
+
+    /**
+     * @brief Returns the vertex centroid. Every axis of symmetry passes 
+     *        through this point. Computed in one pass without allocating, 
+     *        as the symmetry queries need nothing else of the geometry.
+     * @return The average of the vertices.
+     */
+    Point centroid() const;
+
+    /**
+     * @brief Finds all axes of symmetry for the polygon. The axes are 
+     *        cached per EPS, so only the first call with a given 
+     *        tolerance searches for them.
      * @param EPS Tolerance for floating point comparisons.
      * @return A vector of rays defining the axes of symmetry.
      */
     std::vector<Ray> find_axes_of_symmetry(double EPS = EPS_DEFAULT) const;
 
+    /**
+     * @brief Finds all axes of symmetry for the polygon, allocating the 
+     *        result from the given memory resource.
+     * @param resource Memory resource for the result vector.
+     * @param EPS Tolerance for floating point comparisons.
+     * @return A vector of rays defining the axes of symmetry.
+     */
+    std::pmr::vector<Ray> find_axes_of_symmetry(
+        std::pmr::memory_resource *resource,
+        double EPS = EPS_DEFAULT) const;
+
+    /**
+     * @brief Finds the axes of symmetry of the outline this polygon was 
+     *        simplified from. The axes of this polygon are checked 
+     *        against the original one, which is searched instead if 
+     *        any of them does not hold there.
+     * @param original The outline the axes must hold for.
+     * @param resource Memory resource for the result vector.
+     * @param EPS Tolerance for floating point comparisons.
+     * @return The axes of symmetry of the original outline.
+     */
+    std::pmr::vector<Ray> find_axes_of_symmetry(
+        const ConvexPolygon &original,
+        std::pmr::memory_resource *resource,
+        double EPS = EPS_DEFAULT) const;
+
+    /**
+     * @brief Returns the axes of symmetry as a lazily evaluated range, 
+     *        which searches for the next axis only when it is needed.
+     *        The polygon must outlive the range.
+     * @param EPS Tolerance for floating point comparisons.
+     * @return The range of the axes.
+     */
+    AxisRange axes(double EPS = EPS_DEFAULT) const;
+
+    /**
+     * @brief Checks if the polygon has any axis of symmetry, stopping at 
+     *        the first one found.
+     * @param EPS Tolerance for floating point comparisons.
+     * @return True if the polygon is symmetric.
+     */
+    bool has_symmetry(double EPS = EPS_DEFAULT) const;
+
+    /**
+     * @brief Checks if the outline this polygon was simplified from is 
+     *        symmetric, stopping at the first axis of this polygon that 
+     *        also holds for it. The original outline is searched itself 
+     *        if an axis of this polygon does not hold there.
+     * @param original The outline the axes must hold for.
+     * @param EPS Tolerance for floating point comparisons.
+     * @return True if the original outline is symmetric.
+     */
+    bool has_symmetry(const ConvexPolygon &original,
+                      double EPS = EPS_DEFAULT) const;
+
+    /**
+     * @brief Counts the axes of symmetry without storing them.
+     * @param EPS Tolerance for floating point comparisons.
+     * @return The number of axes of symmetry.
+     */
+    std::size_t count_axes(double EPS = EPS_DEFAULT) const;
+
+    /**
+     * @brief Checks which of the given axes are axes of symmetry. The 
+     *        vertex pairs are compared in the axis frame used by 
+     *        find_axes_of_symmetry(), so both accept the same axes, and 
+     *        every pass over a tile of vertices checks a block of axes.
+     * @param axes Pointer to the first axis.
+     * @param count Number of axes.
+     * @param EPS Tolerance for floating point comparisons.
+     * @return Bit i is set if the polygon is symmetric about axis i.
+     */
+    std::vector<bool> verify_axes(const Ray *axes, std::size_t count,
+                                  double EPS = EPS_DEFAULT) const;
+
+    /**
+     * @brief Checks which of the given axes are axes of symmetry.
+     * @tparam Container Contiguous container of rays.
+     * @param axes The axes to check.
+     * @param EPS Tolerance for floating point comparisons.
+     * @return Bit i is set if the polygon is symmetric about axis i.
+     */
+    template <typename Container>
+    std::vector<bool> verify_axes(const Container &axes,
+                                  double EPS = EPS_DEFAULT) const
+    {
+        return verify_axes(axes.data(), axes.size(), EPS);
+    }
+
+    /**
+     * @brief Removes the axes that are not axes of symmetry of this 
+     *        polygon, e.g. the axes found on a coarser simplification 
+     *        of its outline.
+     * @tparam Container Vector-like container of rays.
+     * @param axes The axes to filter, in their original order.
+     * @param EPS Tolerance for floating point comparisons.
+     */
+    template <typename Container>
+    void retain_axes(Container &axes, double EPS = EPS_DEFAULT) const
+    {
+        std::vector<bool> holds = verify_axes(axes, EPS);
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i < axes.size(); ++i)
+        {
+            if (holds[i])
+                axes[kept++] = axes[i];
+        }
+        axes.erase(axes.begin() + kept, axes.end());
+    }
+
+    /**
+     * @brief Finds every rigid transformation, reflections included, that 
+     *        maps this polygon onto another one. The edge length and angle 
+     *        signatures are compared at the shifts that pair the least 
+     *        common entry with a matching one, found through a grid of 
+     *        spacing EPS, so the search takes O(n) expected time unless 
+     *        the signature is nearly regular.
+     * @param other The polygon to match.
+     * @param EPS Tolerance for comparing edge lengths and angles.
+     * @return One transformation per vertex correspondence, empty if the 
+     *         polygons are not congruent.
+     */
+    std::vector<TransformMatrix> match(const ConvexPolygon &other,
+                                       double EPS = EPS_DEFAULT) const;
+
+    /**
+     * @brief Transforms every vertex of the polygon in a single pass.
+     * @param chain The transformations to apply.
+     * @return The transformed polygon, using the same allocator.
+     * @throws std::invalid_argument if the transformation is singular.
+     */
+    ConvexPolygon transformed(const TransformChain &chain) const;
+
 private:
-    std::vector<Point> points;
+    // Splits the validation and the axis search of large polygons 
+    // into tasks
+    friend class BatchAnalyzer;
+
+    std::pmr::vector<Point> points;
+
+    /**
+     * @brief Constructs a polygon without vertices.
+     * @param alloc Allocator used for the vertex storage.
+     */
+    explicit ConvexPolygon(const allocator_type &alloc) : points(alloc) {}
+
+    /**
+     * @brief Returns the number of candidate axes. Every axis of symmetry 
+     *        goes through a vertex or an edge midpoint, and through the 
+     *        vertex or midpoint opposite to it.
+     * @return The number of candidates, equal to the number of vertices.
+     */
+    std::size_t candidate_count() const { return points.size(); }
+
+    PolygonCache cache; ///< Derived properties, computed on first use.
+
+    /**
+     * @brief Returns the derived geometry, computing it on first use.
+     * @return The cached geometry.
+     */
+    const PolygonCache::Geometry &geometry() const
+    {
+        return cache.geometry(points.data(), points.size(),
+                              points.get_allocator().resource());
+    }
+
+    /**
+     * @brief Checks a block of at most VERIFY_BLOCK axes for verify_axes().
+     * @param axes Pointer to the first axis of the block.
+     * @param count Number of axes in the block.
+     * @param EPS Tolerance for floating point comparisons.
+     * @param holds Receives whether each axis holds.
+     */
+    void verify_axis_block(const Ray *axes, std::size_t count, double EPS,
+                           bool *holds) const;
+
+    /// Number of axes verify_axes() checks per pass over the vertices.
+    static constexpr std::size_t VERIFY_BLOCK = 8;
+
+    /// Number of vertices verify_axes() checks for a block at a time.
+    static constexpr std::size_t VERIFY_TILE = 256;
+
+    /**
+     * @brief Checks a candidate axis of symmetry. Candidates that miss 
+     *        the vertex centroid are rejected without the full check.
+     * @param candidate Index of the candidate, less than candidate_count().
+     * @param centroid The vertex centroid of the polygon.
+     * @param EPS Tolerance for floating point comparisons.
+     * @param work If not null, receives the number of vertex pairs the 
+     *        check compared, at least 1 for a pruned candidate.
+     * @return The axis, if the polygon is symmetric about it.
+     */
+    std::optional<Ray> test_candidate(std::size_t candidate,
+                                      const Point &centroid, double EPS,
+                                      std::size_t *work = nullptr) const;
+
+    /**
+     * @brief Checks that the vertices on both sides of an axis are 
+     *        mirror images of each other.
+     * @param axis The axis to check.
+     * @param forward Index of the first vertex on one side of the axis.
+     * @param reverse Index of the vertex opposite to it.
+     * @param EPS Tolerance for floating point comparisons.
+     * @return True if the polygon is symmetric about the axis.
+     */
+    bool is_axis_symmetric(const Ray &axis, std::size_t forward,
+                           std::size_t reverse, double EPS) const;
 
     /**
      * @brief Checks if the polygon formed by the points is convex.
      * @return True if the polygon is convex, false otherwise.
      */
     bool is_convex() const;
+
+    /**
+     * @brief Checks if the polygon formed by the points is convex, 
+     *        splitting the check over several threads.
+     * @return True if the polygon is convex, false otherwise.
+     */
+    bool is_convex_parallel() const;
 };
 
 template <typename InputIt>
-ConvexPolygon::ConvexPolygon(InputIt first, InputIt last)
+ConvexPolygon::ConvexPolygon(InputIt first, InputIt last,
+                             const allocator_type &alloc)
+    : points(alloc)
 {
 #if __cplusplus > 201703L
     if constexpr (!std::is_same_v<InputIt::value_type, Point>) {
@@ -70,3 +498,39 @@ ConvexPolygon::ConvexPolygon(InputIt first, InputIt last)
         );
     }
 }
+
+template <typename InputIt>
+ConvexPolygon::ConvexPolygon(InputIt first, InputIt last,
+                             const VertexSimplifier &simplifier,
+                             const allocator_type &alloc)
+    : points(alloc)
+{
+    std::copy(first, last, std::back_inserter(points));
+    simplifier.simplify(points);
+    if (!is_convex())
+    {
+        throw std::invalid_argument(
+            "Points do not form a convex polygon."
+        );
+    }
+}
+
+template <typename ExecutionPolicy, typename InputIt, typename>
+ConvexPolygon::ConvexPolygon(ExecutionPolicy &&, InputIt first, InputIt last,
+                             const allocator_type &alloc)
+    : points(alloc)
+{
+    std::copy(first, last, std::back_inserter(points));
+
+    bool convex = std::is_same_v<
+        std::decay_t<ExecutionPolicy>, std::execution::sequenced_policy>
+        ? is_convex()
+        : is_convex_parallel();
+
+    if (!convex)
+    {
+        throw std::invalid_argument(
+            "Points do not form a convex polygon."
+        );
+    }
+}
@@ -0,0 +1,94 @@
+#include "ConvexityCheck.h"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+ConvexityCheck::ConvexityCheck(const Point *points, std::size_t count)
+    : points(points), count(count) {}
+
+ConvexityCheck::Turns ConvexityCheck::turns(
+    std::size_t first, std::size_t last, const std::atomic<bool> *stop) const
+{
+    // How often the stop flag is polled
+    const std::size_t poll_interval = 4096;
+
+    Turns result;
+    for (std::size_t i = first; i < last; ++i)
+    {
+        const Point &p0 = points[i];
+        const Point &p1 = points[(i + 1) % count];
+        const Point &p2 = points[(i + 2) % count];
+
+        Vector v1 = p1 - p0;
+        Vector v2 = p2 - p1;
+
+        if (v1.cross_product(v2) > 0)
+            result.positive = true;
+        else
+            result.non_positive = true;
+
+        if (result.mixed())
+            break;
+
+        if (stop && (i - first) % poll_interval == 0
+            && stop->load(std::memory_order_relaxed))
+            break;
+    }
+    return result;
+}
+
+bool ConvexityCheck::is_convex() const
+{
+    if (count < 3) return false;
+
+    return !turns(0, count).mixed();
+}
+
+bool ConvexityCheck::is_convex_parallel(std::size_t threads) const
+{
+    if (count < 3) return false;
+
+    if (threads == 0)
+        threads = std::max(std::thread::hardware_concurrency(), 1u);
+
+    threads = std::min(threads, count / PARALLEL_THRESHOLD + 1);
+    if (threads <= 1)
+        return is_convex();
+
+    // Every chunk reads two vertices past its end, 
+    // so neighbouring chunks overlap at the boundaries
+    const std::size_t chunk = (count + threads - 1) / threads;
+
+    std::atomic<bool> positive{false};
+    std::atomic<bool> non_positive{false};
+    std::atomic<bool> violation{false};
+
+    auto check_chunk =
+        [&](std::size_t first, std::size_t last)
+    {
+        Turns found = turns(first, last, &violation);
+        if (found.positive)
+            positive.store(true, std::memory_order_relaxed);
+        if (found.non_positive)
+            non_positive.store(true, std::memory_order_relaxed);
+
+        // Two chunks turning in different directions are a violation too
+        if (found.mixed()
+            || (positive.load(std::memory_order_relaxed)
+                && non_positive.load(std::memory_order_relaxed)))
+            violation.store(true, std::memory_order_relaxed);
+    };
+
+    std::vector<std::thread> workers;
+    for (std::size_t first = chunk; first < count; first += chunk)
+        workers.emplace_back(
+            check_chunk, first, std::min(first + chunk, count));
+
+    check_chunk(0, std::min(chunk, count));
+
+    for (auto &worker : workers)
+        worker.join();
+
+    return !(positive.load() && non_positive.load());
+}
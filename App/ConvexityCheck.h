@@ -0,0 +1,70 @@
+#pragma once
+
+#include "Point.h"
+
+#include <atomic>
+#include <cstddef>
+
+/**
+ * @class ConvexityCheck
+ * @brief Checks whether a closed chain of points turns in one direction 
+ *        only, serially or split into chunks checked in parallel.
+ */
+class ConvexityCheck
+{
+public:
+    /**
+     * @struct Turns
+     * @brief Directions of the turns found in a range of vertices.
+     */
+    struct Turns
+    {
+        bool positive = false;     ///< A turn with a positive cross product.
+        bool non_positive = false; ///< A turn with a non-positive one.
+
+        /**
+         * @brief Checks if the turns go in both directions.
+         */
+        bool mixed() const { return positive && non_positive; }
+    };
+
+    /**
+     * @brief Constructs a check over an array of points.
+     * @param points Pointer to the first point.
+     * @param count Number of points.
+     */
+    ConvexityCheck(const Point *points, std::size_t count);
+
+    /**
+     * @brief Finds the directions of the turns made by the edges starting 
+     *        at the vertices first to last - 1 and the edges following 
+     *        them. Stops as soon as both directions are found.
+     * @param first Index of the first vertex of the range.
+     * @param last Index past the last vertex of the range.
+     * @param stop Flag telling the check to give up, may be nullptr.
+     * @return The directions found.
+     */
+    Turns turns(std::size_t first, std::size_t last,
+                const std::atomic<bool> *stop = nullptr) const;
+
+    /**
+     * @brief Checks the whole chain serially.
+     * @return True if the points form a convex polygon.
+     */
+    bool is_convex() const;
+
+    /**
+     * @brief Checks the whole chain in chunks on several threads. 
+     *        The first chunk to find a violation stops the others.
+     *        Chains shorter than PARALLEL_THRESHOLD are checked serially.
+     * @param threads Number of threads, 0 for the hardware concurrency.
+     * @return True if the points form a convex polygon.
+     */
+    bool is_convex_parallel(std::size_t threads = 0) const;
+
+    static constexpr std::size_t PARALLEL_THRESHOLD = 1 << 16;
+
+private:
+    const Point *points;
+    std::size_t count;
+};
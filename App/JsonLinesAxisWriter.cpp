@@ -0,0 +1,97 @@
+#include "JsonLinesAxisWriter.h"
+
+#include <cmath>
+
+JsonLinesAxisWriter::JsonLinesAxisWriter(std::ostream &output)
+    : AxisWriter(output) {}
+
+void JsonLinesAxisWriter::format_axes(
+    std::string_view label, const Ray *axes, std::size_t count)
+{
+    put_object_start(label);
+    put("\"axes\":[");
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const Ray &axis = axes[i];
+        if (i != 0)
+            put(',');
+
+        put('[');
+        put_json_number(axis.start_point.x);
+        put(',');
+        put_json_number(axis.start_point.y);
+        put(',');
+        put_json_number(axis.start_point.x + axis.direction.x);
+        put(',');
+        put_json_number(axis.start_point.y + axis.direction.y);
+        put(']');
+    }
+
+    put("]}\n");
+}
+
+void JsonLinesAxisWriter::format_symmetry(
+    std::string_view label, bool symmetric)
+{
+    put_object_start(label);
+    put(symmetric ? "\"symmetric\":true}\n" : "\"symmetric\":false}\n");
+}
+
+void JsonLinesAxisWriter::format_error(
+    std::string_view label, std::string_view message)
+{
+    put_object_start(label);
+    put("\"error\":");
+    put_string(message);
+    put("}\n");
+}
+
+void JsonLinesAxisWriter::put_object_start(std::string_view label)
+{
+    put('{');
+    if (!label.empty())
+    {
+        put("\"label\":");
+        put_string(label);
+        put(',');
+    }
+}
+
+void JsonLinesAxisWriter::put_string(std::string_view text)
+{
+    static const char hex_digits[] = "0123456789abcdef";
+
+    put('"');
+    for (char c : text)
+    {
+        switch (c)
+        {
+        case '"': put("\\\""); break;
+        case '\\': put("\\\\"); break;
+        case '\n': put("\\n"); break;
+        case '\r': put("\\r"); break;
+        case '\t': put("\\t"); break;
+        default:
+            if ((unsigned char)c < 0x20)
+            {
+                put("\\u00");
+                put(hex_digits[(unsigned char)c >> 4]);
+                put(hex_digits[(unsigned char)c & 0xF]);
+            }
+            else
+            {
+                put(c);
+            }
+        }
+    }
+    put('"');
+}
+
+void JsonLinesAxisWriter::put_json_number(double value)
+{
+    if (std::isfinite(value))
+        put_number(value);
+    else
+        put("null");
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "AxisWriter.h"
+
+/**
+ * @class JsonLinesAxisWriter
+ * @brief Writes one JSON object per polygon and line:
+ *        {"label":"...","axes":[[x1,y1,x2,y2],...]} or
+ *        {"label":"...","symmetric":true} or
+ *        {"label":"...","error":"..."}. The label is omitted when empty.
+ */
+class JsonLinesAxisWriter : public AxisWriter
+{
+public:
+    /**
+     * @brief Constructs a writer over an output stream.
+     * @param output The stream to write to.
+     */
+    explicit JsonLinesAxisWriter(std::ostream &output);
+
+protected:
+    void format_axes(
+        std::string_view label, const Ray *axes, std::size_t count) override;
+
+    void format_symmetry(std::string_view label, bool symmetric) override;
+
+    void format_error(
+        std::string_view label, std::string_view message) override;
+
+private:
+    /**
+     * @brief Appends the opening brace and the label member.
+     * @param label Name of the polygon.
+     */
+    void put_object_start(std::string_view label);
+
+    /**
+     * @brief Appends a quoted and escaped JSON string.
+     * @param text The string to append.
+     */
+    void put_string(std::string_view text);
+
+    /**
+     * @brief Appends a JSON number, or null for non-finite values.
+     * @param value The number to append.
+     */
+    void put_json_number(double value);
+};
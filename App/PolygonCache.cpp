@@ -0,0 +1,161 @@
+#include "PolygonCache.h"
+
+#include <cmath>
+#include <new>
+
+PolygonCache::Geometry::Geometry(std::pmr::memory_resource *resource)
+    : edges(resource), signature(resource) {}
+
+PolygonCache::~PolygonCache()
+{
+    clear();
+}
+
+const PolygonCache::Geometry &PolygonCache::geometry(
+    const Point *points, std::size_t count,
+    std::pmr::memory_resource *resource) const
+{
+    State &s = state(resource);
+
+    std::call_once(s.geometry_once, [&]
+    {
+        Geometry &g = s.geometry.emplace(s.resource);
+        if (count == 0)
+            return;
+
+        g.edges.reserve(count);
+        g.signature.reserve(count);
+
+        double twice_area = 0;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const Point &p = points[i];
+            const Point &q = points[i + 1 == count ? 0 : i + 1];
+
+            g.edges.push_back(q - p);
+            twice_area += p.x * q.y - q.x * p.y;
+        }
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const Vector &previous = g.edges[i == 0 ? count - 1 : i - 1];
+            const Vector &edge = g.edges[i];
+
+            double length = std::hypot(edge.x, edge.y);
+            double angle = std::atan2(
+                std::abs(previous.cross_product(edge)),
+                previous.dot_product(edge));
+
+            g.signature.push_back({length, angle});
+            g.perimeter += length;
+        }
+
+        g.area = std::abs(twice_area) / 2;
+    });
+
+    return *s.geometry;
+}
+
+const std::pmr::vector<Ray> *PolygonCache::find_axes(double EPS) const
+{
+    State *s = current.load(std::memory_order_acquire);
+    if (s == nullptr)
+        return nullptr;
+
+    for (AxesEntry *entry = s->axes.load(std::memory_order_acquire);
+         entry != nullptr; entry = entry->next)
+    {
+        if (entry->EPS == EPS)
+            return &entry->axes;
+    }
+    return nullptr;
+}
+
+const std::pmr::vector<Ray> *PolygonCache::store_axes(
+    double EPS, const Ray *axes, std::size_t count,
+    std::pmr::memory_resource *resource) const
+{
+    State &s = state(resource);
+
+    // A caller sweeping over many tolerances would otherwise grow 
+    // the list, and the lookups walking it, without bound
+    if (s.axes_count.fetch_add(1, std::memory_order_relaxed)
+        >= MAX_AXES_ENTRIES)
+    {
+        s.axes_count.fetch_sub(1, std::memory_order_relaxed);
+        return find_axes(EPS);
+    }
+
+    std::pmr::polymorphic_allocator<AxesEntry> alloc(s.resource);
+
+    AxesEntry *entry = alloc.allocate(1);
+    new (entry) AxesEntry{
+        EPS, std::pmr::vector<Ray>(axes, axes + count, s.resource), nullptr};
+
+    AxesEntry *head = s.axes.load(std::memory_order_acquire);
+    AxesEntry *checked = nullptr;
+    for (;;)
+    {
+        // Only the entries added since the last attempt need checking
+        for (AxesEntry *other = head; other != checked; other = other->next)
+        {
+            if (other->EPS == EPS)
+            {
+                entry->~AxesEntry();
+                alloc.deallocate(entry, 1);
+                s.axes_count.fetch_sub(1, std::memory_order_relaxed);
+                return &other->axes;
+            }
+        }
+        checked = head;
+
+        entry->next = head;
+        if (s.axes.compare_exchange_weak(head, entry,
+                                         std::memory_order_acq_rel,
+                                         std::memory_order_acquire))
+            return &entry->axes;
+    }
+}
+
+PolygonCache::State &PolygonCache::state(
+    std::pmr::memory_resource *resource) const
+{
+    State *s = current.load(std::memory_order_acquire);
+    if (s != nullptr)
+        return *s;
+
+    std::pmr::polymorphic_allocator<State> alloc(resource);
+    State *created = alloc.allocate(1);
+    new (created) State(resource);
+
+    if (current.compare_exchange_strong(s, created,
+                                        std::memory_order_acq_rel,
+                                        std::memory_order_acquire))
+        return *created;
+
+    // Another thread allocated the state first
+    created->~State();
+    alloc.deallocate(created, 1);
+    return *s;
+}
+
+void PolygonCache::clear() noexcept
+{
+    State *s = current.exchange(nullptr, std::memory_order_acq_rel);
+    if (s == nullptr)
+        return;
+
+    std::pmr::polymorphic_allocator<AxesEntry> entries(s->resource);
+    for (AxesEntry *entry = s->axes.load(std::memory_order_relaxed);
+         entry != nullptr;)
+    {
+        AxesEntry *next = entry->next;
+        entry->~AxesEntry();
+        entries.deallocate(entry, 1);
+        entry = next;
+    }
+
+    std::pmr::polymorphic_allocator<State> alloc(s->resource);
+    s->~State();
+    alloc.deallocate(s, 1);
+}
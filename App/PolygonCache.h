@@ -0,0 +1,163 @@
+#pragma once
+
+#include "Point.h"
+#include "Ray.h"
+#include "Vector.h"
+
+#include <atomic>
+#include <cstddef>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+/**
+ * @class PolygonCache
+ * @brief Derived data of a polygon, computed on first use and then
+ *        read without locking. Safe to query from several threads.
+ *        The cache is not copied along with its polygon: a copy starts
+ *        empty and computes its own data.
+ */
+class PolygonCache
+{
+public:
+    /**
+     * @struct SignatureEntry
+     * @brief Length of an edge and the turning angle at the vertex it
+     *        starts from. The angle does not depend on the orientation.
+     */
+    struct SignatureEntry
+    {
+        double length; ///< Length of the edge.
+        double angle;  ///< Angle between the previous edge and this one.
+    };
+
+    /**
+     * @struct Geometry
+     * @brief Properties computed together in one pass over the vertices.
+     */
+    struct Geometry
+    {
+        /**
+         * @brief Constructs empty geometry allocating from a resource.
+         * @param resource Memory resource for the edge data.
+         */
+        explicit Geometry(std::pmr::memory_resource *resource);
+
+        std::pmr::vector<Vector> edges; ///< Edge i goes from vertex i to i + 1.
+        std::pmr::vector<SignatureEntry> signature; ///< One entry per edge.
+        double perimeter = 0; ///< Sum of the edge lengths.
+        double area = 0;      ///< Enclosed area.
+    };
+
+    PolygonCache() = default;
+
+    PolygonCache(const PolygonCache &) noexcept {}
+
+    /**
+     * @brief Takes over the data of a polygon whose vertices are moved 
+     *        along with it.
+     */
+    PolygonCache(PolygonCache &&other) noexcept
+        : current(other.current.exchange(nullptr)) {}
+
+    /**
+     * @brief Drops the cached data. The polygon is being reassigned,
+     *        so no other thread may be reading it.
+     */
+    PolygonCache &operator=(const PolygonCache &) noexcept
+    {
+        clear();
+        return *this;
+    }
+
+    /**
+     * @brief Drops the cached data of both polygons, as the vertices may 
+     *        have been copied rather than moved.
+     */
+    PolygonCache &operator=(PolygonCache &&other) noexcept
+    {
+        clear();
+        other.clear();
+        return *this;
+    }
+
+    ~PolygonCache();
+
+    /**
+     * @brief Returns the geometry of a polygon, computing it on first use.
+     * @param points Pointer to the first vertex.
+     * @param count Number of vertices.
+     * @param resource Memory resource for the cached data.
+     * @return The cached geometry.
+     */
+    const Geometry &geometry(const Point *points, std::size_t count,
+                             std::pmr::memory_resource *resource) const;
+
+    /**
+     * @brief Looks up the axes of symmetry found with a tolerance.
+     * @param EPS The tolerance used for the search.
+     * @return The cached axes, or nullptr if none were stored for EPS.
+     */
+    const std::pmr::vector<Ray> *find_axes(double EPS) const;
+
+    /**
+     * @brief Stores a copy of the axes of symmetry found with a tolerance. 
+     *        If another thread stored them first, its axes are kept. 
+     *        Nothing is stored once MAX_AXES_ENTRIES tolerances are cached.
+     * @param EPS The tolerance used for the search.
+     * @param axes Pointer to the first axis.
+     * @param count Number of axes.
+     * @param resource Memory resource for the cached data.
+     * @return The cached axes, or nullptr if the cache is full.
+     */
+    const std::pmr::vector<Ray> *store_axes(
+        double EPS, const Ray *axes, std::size_t count,
+        std::pmr::memory_resource *resource) const;
+
+    /// Most tolerances the axes are cached for.
+    static constexpr std::size_t MAX_AXES_ENTRIES = 4;
+
+private:
+    /**
+     * @struct AxesEntry
+     * @brief Axes found with one tolerance, in a list that is only
+     *        ever prepended to.
+     */
+    struct AxesEntry
+    {
+        double EPS;
+        std::pmr::vector<Ray> axes;
+        AxesEntry *next;
+    };
+
+    /**
+     * @struct State
+     * @brief Cached data, allocated on first use.
+     */
+    struct State
+    {
+        explicit State(std::pmr::memory_resource *resource)
+            : resource(resource) {}
+
+        std::pmr::memory_resource *resource; ///< Source of all the data.
+        std::once_flag geometry_once;
+        std::optional<Geometry> geometry;
+        std::atomic<AxesEntry *> axes{nullptr}; ///< Most recent entry first.
+        std::atomic<std::size_t> axes_count{0}; ///< Entries and reservations.
+    };
+
+    /**
+     * @brief Returns the state, allocating it if this is the first use.
+     * @param resource Memory resource for the state.
+     * @return The state.
+     */
+    State &state(std::pmr::memory_resource *resource) const;
+
+    /**
+     * @brief Destroys the state and everything cached in it.
+     */
+    void clear() noexcept;
+
+    mutable std::atomic<State *> current{nullptr};
+};
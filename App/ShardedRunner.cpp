@@ -0,0 +1,401 @@
+#include "ShardedRunner.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    std::string quote(const std::string &argument)
+    {
+#ifdef _WIN32
+        return '"' + argument + '"';
+#else
+        std::string result = "'";
+        for (char c : argument)
+        {
+            if (c == '\'')
+                result += "'\\''";
+            else
+                result += c;
+        }
+        return result + "'";
+#endif
+    }
+
+    /**
+     * @brief Checks if the status returned by std::system is a successful 
+     *        exit of the command.
+     */
+    bool exited_successfully(int status)
+    {
+#ifdef _WIN32
+        return status == 0;
+#else
+        return status != -1 && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+#endif
+    }
+
+    /**
+     * @brief Writes the data of a file, or the entries of a directory, 
+     *        from the caches of the operating system to the disk.
+     * @throws std::runtime_error if the file cannot be synced.
+     */
+    void sync_to_disk(const fs::path &path, bool directory = false)
+    {
+#ifdef _WIN32
+        // Renames are journaled by NTFS, directories cannot be committed
+        if (directory)
+            return;
+
+        int fd = _wopen(path.c_str(), _O_WRONLY | _O_BINARY);
+        bool synced = fd != -1 && _commit(fd) == 0;
+        if (fd != -1)
+            _close(fd);
+#else
+        int fd = ::open(path.c_str(), directory ? O_RDONLY : O_WRONLY);
+        bool synced = fd != -1 && ::fsync(fd) == 0;
+        if (fd != -1)
+            ::close(fd);
+#endif
+
+        if (!synced)
+            throw std::runtime_error("Unable to sync " + path.string() + ".");
+    }
+
+    /**
+     * @brief Copies the first size bytes of a file to a stream.
+     */
+    void copy_prefix(const fs::path &path, std::uint64_t size, std::ostream &output)
+    {
+        std::ifstream input(path, std::ios::binary);
+        std::vector<char> buffer(1 << 20);
+
+        while (size > 0 && input)
+        {
+            auto chunk = (std::size_t)std::min<std::uint64_t>(size, buffer.size());
+            input.read(buffer.data(), chunk);
+            output.write(buffer.data(), input.gcount());
+            size -= input.gcount();
+        }
+
+        if (size != 0)
+            throw std::runtime_error("Unable to read shard log.");
+    }
+}
+
+ShardedRunner::Options::Options()
+{
+    std::size_t threads =
+        std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+
+    shards = threads;
+    jobs = threads;
+    retries = 3;
+    checkpoint_interval = 1000;
+    format = OutputFormat::Text;
+}
+
+ShardedRunner::ShardedRunner(const Options &options)
+    : options(options) {}
+
+int ShardedRunner::run(std::ostream &output) const
+{
+    fs::create_directories(options.output_dir);
+
+    // A resumed run has to split the manifest in the same way and 
+    // produce the same records as the logs it continues
+    std::ostringstream layout;
+    layout << options.shards << ' ' << fs::file_size(options.manifest)
+           << ' ' << (int)options.format << '\n';
+    for (const auto &argument : options.worker_arguments)
+        layout << argument << '\n';
+
+    fs::path layout_path = options.output_dir / "layout";
+    if (fs::exists(layout_path))
+    {
+        std::ifstream file(layout_path, std::ios::binary);
+        std::ostringstream saved;
+        saved << file.rdbuf();
+        if (saved.str() != layout.str())
+        {
+            throw std::runtime_error(
+                "Output directory holds a run of another manifest, shard "
+                "count or worker arguments.");
+        }
+    }
+    else
+    {
+        std::ofstream(layout_path, std::ios::binary) << layout.str();
+    }
+
+    std::vector<char> finished(options.shards, false);
+    std::vector<std::string> errors(options.shards);
+    std::atomic<std::size_t> next{0};
+
+    std::mutex failure_mutex;
+    std::exception_ptr failure;
+
+    auto run_workers =
+        [&]
+    {
+        try
+        {
+            for (std::size_t shard; (shard = next++) < options.shards;)
+            {
+                // Every run that leaves the shard unfinished is a failure,
+                // including a worker exiting successfully too early
+                for (std::size_t failures = 0;; ++failures)
+                {
+                    auto checkpoint = load_checkpoint(shard);
+                    if (checkpoint && checkpoint->done)
+                    {
+                        finished[shard] = true;
+                        break;
+                    }
+
+                    if (failures > options.retries)
+                        break;
+
+                    int status = std::system(worker_command(shard).c_str());
+                    errors[shard] = exited_successfully(status)
+                        ? "the worker exited before finishing it"
+                        : "the worker failed with status "
+                          + std::to_string(status);
+                }
+            }
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(failure_mutex);
+            if (!failure)
+                failure = std::current_exception();
+            next = options.shards;
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < std::min(options.jobs, options.shards); ++i)
+        threads.emplace_back(run_workers);
+    for (auto &thread : threads)
+        thread.join();
+
+    if (failure)
+        std::rethrow_exception(failure);
+
+    for (std::size_t shard = 0; shard < options.shards; ++shard)
+    {
+        if (!finished[shard])
+        {
+            throw std::runtime_error(
+                "Shard " + std::to_string(shard) + " could not be finished: "
+                + errors[shard] + ".");
+        }
+    }
+
+    std::uint64_t failures = 0;
+    for (std::size_t shard = 0; shard < options.shards; ++shard)
+    {
+        auto checkpoint = load_checkpoint(shard);
+        copy_prefix(log_path(shard), checkpoint->log_size, output);
+        failures += checkpoint->failures;
+    }
+    output.flush();
+
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int ShardedRunner::run_shard(std::size_t shard, const Job &job) const
+{
+    if (shard >= options.shards)
+        throw std::invalid_argument("Shard index out of range.");
+
+    const std::uint64_t manifest_size = fs::file_size(options.manifest);
+    const std::uint64_t end = align_to_line(
+        manifest_size * (shard + 1) / options.shards);
+
+    Checkpoint checkpoint;
+    if (auto saved = load_checkpoint(shard))
+    {
+        checkpoint = *saved;
+        if (checkpoint.done)
+            return EXIT_SUCCESS;
+    }
+    else
+    {
+        checkpoint.manifest_offset =
+            align_to_line(manifest_size * shard / options.shards);
+    }
+
+    // Drop the records written after the last checkpoint
+    const fs::path path = log_path(shard);
+    if (fs::exists(path))
+        fs::resize_file(path, checkpoint.log_size);
+
+    std::ofstream log(path, std::ios::binary | std::ios::app);
+    std::ifstream manifest(options.manifest, std::ios::binary);
+    if (!log.is_open() || !manifest.is_open())
+        throw std::runtime_error("Unable to open file.");
+
+    auto writer = make_axis_writer(options.format, log, log);
+
+    auto commit =
+        [&](std::uint64_t offset, bool done)
+    {
+        writer->flush();
+        if (!log.flush())
+            throw std::runtime_error("Unable to write shard log.");
+
+        // The records must be on disk before a checkpoint covers them
+        sync_to_disk(path);
+
+        checkpoint.manifest_offset = offset;
+        checkpoint.log_size = fs::file_size(path);
+        checkpoint.done = done;
+        save_checkpoint(shard, checkpoint);
+    };
+
+    manifest.seekg(checkpoint.manifest_offset);
+    std::uint64_t offset = checkpoint.manifest_offset;
+    std::size_t since_checkpoint = 0;
+
+    std::string filename;
+    while (offset < end && std::getline(manifest, filename))
+    {
+        offset += filename.size() + 1;
+
+        if (!filename.empty() && filename.back() == '\r')
+            filename.pop_back();
+        if (filename.empty())
+            continue;
+
+        try
+        {
+            job(filename, *writer);
+        }
+        catch (const std::exception &e)
+        {
+            writer->write_error(filename, e.what());
+            ++checkpoint.failures;
+        }
+
+        if (++since_checkpoint == options.checkpoint_interval)
+        {
+            commit(offset, false);
+            since_checkpoint = 0;
+        }
+    }
+
+    if (manifest.bad())
+        throw std::runtime_error("Unable to read manifest.");
+
+    commit(offset, true);
+    return EXIT_SUCCESS;
+}
+
+fs::path ShardedRunner::log_path(std::size_t shard) const
+{
+    return options.output_dir / ("shard-" + std::to_string(shard) + ".log");
+}
+
+fs::path ShardedRunner::checkpoint_path(std::size_t shard) const
+{
+    return options.output_dir / ("shard-" + std::to_string(shard) + ".checkpoint");
+}
+
+std::optional<ShardedRunner::Checkpoint> ShardedRunner::load_checkpoint(
+    std::size_t shard) const
+{
+    std::ifstream file(checkpoint_path(shard));
+    if (!file.is_open())
+        return std::nullopt;
+
+    Checkpoint checkpoint;
+    if (!(file >> checkpoint.manifest_offset
+               >> checkpoint.log_size
+               >> checkpoint.failures
+               >> checkpoint.done))
+    {
+        throw std::runtime_error("Invalid checkpoint file.");
+    }
+
+    return checkpoint;
+}
+
+void ShardedRunner::save_checkpoint(
+    std::size_t shard, const Checkpoint &checkpoint) const
+{
+    const fs::path path = checkpoint_path(shard);
+    fs::path temporary = path;
+    temporary += ".tmp";
+
+    {
+        std::ofstream file(temporary, std::ios::trunc);
+        file << checkpoint.manifest_offset << ' '
+             << checkpoint.log_size << ' '
+             << checkpoint.failures << ' '
+             << checkpoint.done << '\n';
+
+        if (!file.flush())
+            throw std::runtime_error("Unable to write checkpoint.");
+    }
+    sync_to_disk(temporary);
+
+    // Replacing the file is atomic, so a crash leaves either checkpoint
+    fs::rename(temporary, path);
+    sync_to_disk(options.output_dir, true);
+}
+
+std::uint64_t ShardedRunner::align_to_line(std::uint64_t offset) const
+{
+    if (offset == 0)
+        return 0;
+
+    std::ifstream manifest(options.manifest, std::ios::binary);
+    manifest.seekg(offset - 1);
+
+    std::string rest;
+    std::getline(manifest, rest);
+
+    // The line containing the byte before the offset ends with rest
+    return offset - 1 + rest.size() + 1;
+}
+
+std::string ShardedRunner::worker_command(std::size_t shard) const
+{
+    std::string command = quote(options.executable);
+
+    for (const auto &argument : options.worker_arguments)
+        command += ' ' + quote(argument);
+
+    command += " --manifest " + quote(options.manifest.string());
+    command += " --out " + quote(options.output_dir.string());
+    command += " --shards " + std::to_string(options.shards);
+    command += " --checkpoint-interval "
+        + std::to_string(options.checkpoint_interval);
+    command += " --shard-worker " + std::to_string(shard);
+
+#ifdef _WIN32
+    // cmd.exe strips the outer quotes of a command starting with one
+    command = '"' + command + '"';
+#endif
+
+    return command;
+}
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "AxisWriter.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @class ShardedRunner
+ * @brief Processes the polygon files listed in a manifest, one per line, 
+ *        by splitting the manifest into shards run in worker processes.
+ *
+ * Every worker appends its results to its own log in the output 
+ * directory and periodically records a checkpoint of how far it got. 
+ * A worker that is restarted, after a crash or when the whole run is 
+ * started again, continues from its last checkpoint. When all shards are 
+ * finished, the parent process concatenates the logs in manifest order.
+ */
+class ShardedRunner
+{
+public:
+    /**
+     * @brief Processes one polygon file, writing its result.
+     * @param filename The name of the polygon file.
+     * @param writer Writer for the result, labelled with the filename.
+     */
+    using Job = std::function<void(const std::string &filename, AxisWriter &writer)>;
+
+    /**
+     * @struct Options
+     * @brief Settings shared by the parent and the worker processes.
+     */
+    struct Options
+    {
+        std::string executable;  ///< Path to the executable of the workers.
+        /// Extra worker arguments. A resumed run must pass the same ones.
+        std::vector<std::string> worker_arguments;
+        std::filesystem::path manifest;   ///< List of polygon files.
+        std::filesystem::path output_dir; ///< Directory for logs and checkpoints.
+        std::size_t shards;      ///< Number of shards of the manifest.
+        std::size_t jobs;        ///< Number of workers running at once.
+        std::size_t retries;     ///< Restarts of a failed worker.
+        std::size_t checkpoint_interval; ///< Polygons between checkpoints.
+        OutputFormat format;     ///< Format of the logs and the result.
+
+        /**
+         * @brief Constructs options with one shard and one running worker 
+         *        per hardware thread.
+         */
+        Options();
+    };
+
+    /**
+     * @brief Constructs a runner.
+     * @param options The settings of the run.
+     */
+    explicit ShardedRunner(const Options &options);
+
+    /**
+     * @brief Runs the unfinished shards in worker processes, restarting 
+     *        the failed ones, and merges the logs into the output.
+     * @param output The stream to write the merged results to.
+     * @return Exit status, failure if a polygon could not be processed.
+     * @throws std::runtime_error if a shard could not be finished within 
+     *         the retries, or if the output directory holds a run with 
+     *         another manifest, shard count, format or worker arguments.
+     */
+    int run(std::ostream &output) const;
+
+    /**
+     * @brief Processes one shard, resuming from its last checkpoint.
+     *        Called in the worker processes.
+     * @param shard Index of the shard.
+     * @param job The processing of a single polygon file.
+     * @return Exit status, failure only if the shard could not be finished.
+     */
+    int run_shard(std::size_t shard, const Job &job) const;
+
+private:
+    /**
+     * @struct Checkpoint
+     * @brief Progress of a shard that is known to be on disk.
+     */
+    struct Checkpoint
+    {
+        std::uint64_t manifest_offset = 0; ///< Start of the next manifest line.
+        std::uint64_t log_size = 0;        ///< Size of the complete log records.
+        std::uint64_t failures = 0;        ///< Polygons that failed so far.
+        bool done = false;                 ///< Whether the shard is finished.
+    };
+
+    std::filesystem::path log_path(std::size_t shard) const;
+    std::filesystem::path checkpoint_path(std::size_t shard) const;
+
+    /**
+     * @brief Reads the checkpoint of a shard.
+     * @return The checkpoint, or nothing if the shard was never started.
+     */
+    std::optional<Checkpoint> load_checkpoint(std::size_t shard) const;
+
+    /**
+     * @brief Replaces the checkpoint of a shard atomically.
+     */
+    void save_checkpoint(std::size_t shard, const Checkpoint &checkpoint) const;
+
+    /**
+     * @brief Finds the first manifest line starting at or after an offset.
+     * @param offset Byte offset in the manifest.
+     * @return Byte offset of the line start.
+     */
+    std::uint64_t align_to_line(std::uint64_t offset) const;
+
+    /**
+     * @brief Builds the command line of the worker for a shard.
+     */
+    std::string worker_command(std::size_t shard) const;
+
+    Options options;
+};
@@ -0,0 +1,311 @@
+#include "StreamPipeline.h"
+
+#include "BoundedQueue.h"
+#include "ConvexPolygon.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    struct RawPolygon
+    {
+        std::size_t index = 0;
+        std::string text;
+    };
+
+    struct ParsedPolygon
+    {
+        std::size_t index = 0;
+        std::vector<Point> points;
+        std::string error;
+    };
+
+    struct ValidPolygon
+    {
+        std::size_t index = 0;
+        std::optional<ConvexPolygon> polygon;
+        /// Outline before a lossy simplification, to check the axes on
+        std::optional<ConvexPolygon> original;
+        std::string error;
+    };
+
+    struct AnalyzedPolygon
+    {
+        std::size_t index = 0;
+        std::vector<Ray> axes;
+        bool symmetric = false;
+        std::string error;
+    };
+
+    std::vector<Point> parse_points(const std::string &text)
+    {
+        std::vector<Point> points;
+        std::istringstream stream(text);
+
+        std::string line;
+        while (std::getline(stream, line))
+        {
+            std::istringstream iss(line);
+            double x, y;
+            if (!(iss >> x >> y))
+            {
+                throw std::runtime_error("Invalid point format in stream.");
+            }
+            points.emplace_back(x, y);
+        }
+
+        return points;
+    }
+
+    /**
+     * @brief Starts the worker threads of one pipeline stage. The last 
+     *        worker to finish closes the output queue.
+     */
+    template <typename In, typename Out, typename Transform>
+    void start_stage(
+        BoundedQueue<In> &in,
+        BoundedQueue<Out> &out,
+        std::size_t workers,
+        Transform transform,
+        std::vector<std::thread> &threads)
+    {
+        auto remaining =
+            std::make_shared<std::atomic<std::size_t>>(workers);
+
+        for (std::size_t i = 0; i < workers; ++i)
+        {
+            threads.emplace_back(
+                [&in, &out, transform, remaining]
+                {
+                    In item;
+                    while (in.pop(item))
+                        out.push(transform(std::move(item)));
+
+                    if (remaining->fetch_sub(1) == 1)
+                        out.close();
+                });
+        }
+    }
+}
+
+StreamPipeline::Options::Options()
+{
+    std::size_t threads =
+        std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+
+    parse_workers = std::max<std::size_t>(threads / 4, 1);
+    validate_workers = std::max<std::size_t>(threads / 8, 1);
+    symmetry_workers = std::max<std::size_t>(
+        threads - std::min(threads, parse_workers + validate_workers + 2),
+        1);
+    queue_capacity = 1024;
+    check_only = false;
+}
+
+StreamPipeline::StreamPipeline(
+    std::istream &input, AxisWriter &writer, const Options &options)
+    : input(input), writer(writer), options(options) {}
+
+std::size_t StreamPipeline::run()
+{
+    BoundedQueue<RawPolygon> raw(options.queue_capacity);
+    BoundedQueue<ParsedPolygon> parsed(options.queue_capacity);
+    BoundedQueue<ValidPolygon> valid(options.queue_capacity);
+    BoundedQueue<AnalyzedPolygon> analyzed(options.queue_capacity);
+
+    // The reader stays at most this many polygons ahead of the writer,
+    // which bounds the results waiting to be written in order
+    const std::size_t window =
+        4 * options.queue_capacity
+        + options.parse_workers
+        + options.validate_workers
+        + options.symmetry_workers;
+
+    std::size_t written = 0;
+    std::mutex written_mutex;
+    std::condition_variable window_moved;
+    std::size_t failures = 0;
+    std::vector<std::thread> threads;
+
+    start_stage(raw, parsed, options.parse_workers,
+        [](RawPolygon item)
+        {
+            ParsedPolygon result;
+            result.index = item.index;
+            try
+            {
+                result.points = parse_points(item.text);
+            }
+            catch (const std::exception &e)
+            {
+                result.error = e.what();
+            }
+            return result;
+        },
+        threads);
+
+    const auto &simplifier = options.simplifier;
+
+    start_stage(parsed, valid, options.validate_workers,
+        [&simplifier](ParsedPolygon item)
+        {
+            ValidPolygon result;
+            result.index = item.index;
+            result.error = std::move(item.error);
+            if (result.error.empty())
+            {
+                try
+                {
+                    if (simplifier && !simplifier->is_exact())
+                        result.original.emplace(
+                            item.points.begin(), item.points.end(),
+                            simplifier->exact());
+
+                    if (simplifier)
+                        result.polygon.emplace(
+                            item.points.begin(), item.points.end(),
+                            *simplifier);
+                    else
+                        result.polygon.emplace(
+                            item.points.begin(), item.points.end());
+                }
+                catch (const std::exception &e)
+                {
+                    result.error = e.what();
+                }
+            }
+            return result;
+        },
+        threads);
+
+    const bool check_only = options.check_only;
+
+    start_stage(valid, analyzed, options.symmetry_workers,
+        [check_only](ValidPolygon item)
+        {
+            AnalyzedPolygon result;
+            result.index = item.index;
+            result.error = std::move(item.error);
+            if (item.polygon && check_only)
+            {
+                result.symmetric = item.original
+                    ? item.polygon->has_symmetry(*item.original)
+                    : item.polygon->has_symmetry();
+            }
+            else if (item.polygon)
+            {
+                if (item.original)
+                {
+                    auto axes = item.polygon->find_axes_of_symmetry(
+                        *item.original, std::pmr::get_default_resource());
+                    result.axes.assign(axes.begin(), axes.end());
+                }
+                else
+                    result.axes = item.polygon->find_axes_of_symmetry();
+            }
+            return result;
+        },
+        threads);
+
+    threads.emplace_back(
+        [&]
+        {
+            std::map<std::size_t, AnalyzedPolygon> pending;
+            std::size_t next = 0;
+
+            AnalyzedPolygon item;
+            while (analyzed.pop(item))
+            {
+                pending.emplace(item.index, std::move(item));
+
+                for (auto it = pending.begin();
+                     it != pending.end() && it->first == next;
+                     it = pending.erase(it))
+                {
+                    const auto &result = it->second;
+                    std::string label =
+                        "Polygon " + std::to_string(result.index);
+
+                    if (!result.error.empty())
+                    {
+                        ++failures;
+                        writer.write_error(label, result.error);
+                    }
+                    else if (check_only)
+                    {
+                        writer.write_symmetry(label, result.symmetric);
+                    }
+                    else
+                    {
+                        writer.write_axes(label, result.axes);
+                    }
+
+                    ++next;
+                }
+
+                {
+                    std::lock_guard<std::mutex> lock(written_mutex);
+                    written = next;
+                }
+                window_moved.notify_one();
+            }
+
+            writer.end_batch();
+        });
+
+    std::string line;
+    std::string text;
+    std::size_t index = 0;
+
+    auto push_polygon = [&]
+    {
+        if (text.empty())
+            return;
+
+        {
+            std::unique_lock<std::mutex> lock(written_mutex);
+            window_moved.wait(
+                lock, [&] { return index < written + window; });
+        }
+
+        raw.push(RawPolygon{index++, std::move(text)});
+        text.clear();
+    };
+
+    while (std::getline(input, line))
+    {
+        if (line.find_first_not_of(" \t\r") == std::string::npos)
+        {
+            push_polygon();
+        }
+        else
+        {
+            text += line;
+            text += '\n';
+        }
+    }
+    push_polygon();
+    raw.close();
+
+    for (auto &thread : threads)
+        thread.join();
+
+    if (input.bad())
+    {
+        throw std::runtime_error("Unable to read the input stream.");
+    }
+
+    return failures;
+}
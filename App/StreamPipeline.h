@@ -0,0 +1,68 @@
+#pragma once
+
+#include "AxisWriter.h"
+#include "VertexSimplifier.h"
+
+#include <cstddef>
+#include <istream>
+#include <optional>
+
+/**
+ * @class StreamPipeline
+ * @brief Finds axes of symmetry for a stream of polygons.
+ *
+ * The input holds one point per line in the "x y" form, polygons are 
+ * separated by one or more blank lines. Reading, parsing, validation, 
+ * the symmetry search and writing run as concurrent stages connected 
+ * by bounded queues, so the memory used does not depend on the length 
+ * of the stream. The results are written in the order of the input, 
+ * labelled "Polygon <index>", and flushed when the stream ends.
+ */
+class StreamPipeline
+{
+public:
+    /**
+     * @struct Options
+     * @brief Number of threads per stage and the size of the queues.
+     */
+    struct Options
+    {
+        std::size_t parse_workers;    ///< Threads parsing the point text.
+        std::size_t validate_workers; ///< Threads checking convexity.
+        std::size_t symmetry_workers; ///< Threads searching for axes.
+        std::size_t queue_capacity;   ///< Capacity of every queue.
+
+        /// Simplification applied to every outline before the validation.
+        std::optional<VertexSimplifier> simplifier;
+
+        /// Whether only the presence of symmetry is written, not the axes.
+        bool check_only;
+
+        /**
+         * @brief Constructs options that spread the stages over all 
+         *        hardware threads.
+         */
+        Options();
+    };
+
+    /**
+     * @brief Constructs a pipeline over the given streams.
+     * @param input Stream to read the polygons from.
+     * @param writer Writer for the results.
+     * @param options Threads and queue sizes.
+     */
+    StreamPipeline(std::istream &input, AxisWriter &writer,
+                   const Options &options = Options());
+
+    /**
+     * @brief Processes the whole input stream.
+     * @return Number of polygons that could not be processed.
+     * @throws std::runtime_error if reading the input fails.
+     */
+    std::size_t run();
+
+private:
+    std::istream &input;
+    AxisWriter &writer;
+    Options options;
+};
@@ -0,0 +1,315 @@
+#include "SymmetryCodec.h"
+
+#include "TransformMatrix.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <stdexcept>
+
+namespace
+{
+    // Point at a boundary position counted in half edges
+    Point boundary_point(const ConvexPolygon &polygon, std::size_t n,
+                         std::size_t position)
+    {
+        position %= 2 * n;
+        const auto &p = *(polygon.begin() + position / 2);
+        if (position % 2 == 0)
+            return p;
+
+        const auto &q = *(polygon.begin() + (position / 2 + 1) % n);
+        return Point((p.x + q.x) / 2, (p.y + q.y) / 2);
+    }
+
+    TransformMatrix reflection(const Ray &axis)
+    {
+        Ray perpendicular(
+            axis.start_point, Vector(-axis.direction.y, axis.direction.x));
+        TransformMatrix frame(axis, perpendicular);
+
+        TransformMatrix flip;
+        flip.set_scaling(1, -1);
+
+        return frame * flip * frame.inverse();
+    }
+
+    template <typename T>
+    void write_raw(std::ostream &output, const T &value)
+    {
+        output.write(reinterpret_cast<const char *>(&value), sizeof(value));
+    }
+
+    template <typename T>
+    T read_raw(std::istream &input)
+    {
+        T value;
+        if (!input.read(reinterpret_cast<char *>(&value), sizeof(value)))
+        {
+            throw std::runtime_error(
+                "Unexpected end of encoded polygon data."
+            );
+        }
+        return value;
+    }
+}
+
+SymmetryCodec::SymmetryCodec(double EPS) : EPS(EPS) {}
+
+SymmetryCodec::Encoded SymmetryCodec::encode(
+    const ConvexPolygon &polygon) const
+{
+    Encoded full;
+    full.points.assign(polygon.begin(), polygon.end());
+    full.vertex_count = (std::uint32_t)full.points.size();
+
+    const auto n = full.points.size();
+    const auto axes = polygon.find_axes_of_symmetry(EPS);
+    const auto k = axes.size();
+    if (k == 0 || n % k != 0)
+        return full;
+
+    // Find where the first axis meets the boundary
+    std::size_t start = 0;
+    double nearest = INFINITY;
+    for (std::size_t position = 0; position < 2 * n; ++position)
+    {
+        auto offset =
+            boundary_point(polygon, n, position) - axes[0].start_point;
+        double distance = offset.dot_product(offset);
+        if (distance < nearest)
+        {
+            nearest = distance;
+            start = position;
+        }
+    }
+
+    // The axes of a polygon with k of them divide the boundary into
+    // 2k parts of n / k half edges each
+    const auto half_edges = n / k;
+
+    // With one half edge per part every position lies on an axis. 
+    // Starting at a midpoint stores the vertex that fixes the second 
+    // axis, instead of one lying on the first axis
+    if (half_edges == 1 && start % 2 == 0)
+        ++start;
+
+    const auto end = start + half_edges;
+
+    Encoded encoded;
+    encoded.vertex_count = full.vertex_count;
+    encoded.order = (std::uint32_t)k;
+    encoded.start = (std::uint32_t)start;
+
+    if (k == 1)
+    {
+        encoded.axis = axes[0];
+    }
+    else
+    {
+        // Every axis passes through the centroid
+        const Point centre = polygon.centroid();
+        encoded.axis = Ray(centre, boundary_point(polygon, n, start) - centre);
+    }
+
+    for (auto position = start + start % 2; position <= end; position += 2)
+        encoded.points.push_back(full.points[position / 2 % n]);
+
+    if (written_size(encoded) >= written_size(full))
+        return full;
+
+    // Keep the compact form only if it rebuilds the polygon
+    try
+    {
+        auto decoded = decode(encoded);
+        auto original = polygon.begin();
+        for (const auto &p : decoded)
+        {
+            if (std::abs(p.x - original->x) > EPS
+                || std::abs(p.y - original->y) > EPS)
+                return full;
+            ++original;
+        }
+    }
+    catch (const std::invalid_argument &)
+    {
+        return full;
+    }
+
+    return encoded;
+}
+
+ConvexPolygon SymmetryCodec::decode(
+    const Encoded &encoded, const ConvexPolygon::allocator_type &alloc) const
+{
+    const std::size_t n = encoded.vertex_count;
+    const std::size_t k = encoded.order;
+
+    if (k == 0)
+    {
+        if (encoded.points.size() != n)
+        {
+            throw std::invalid_argument(
+                "Encoded polygon has a wrong number of points."
+            );
+        }
+        return ConvexPolygon(
+            encoded.points.begin(), encoded.points.end(), alloc);
+    }
+
+    const std::size_t half_edges = n / k;
+    if (n % k != 0
+        || encoded.points.size() != vertices_between(
+               encoded.start, (std::uint32_t)(encoded.start + half_edges)))
+    {
+        throw std::invalid_argument(
+            "Encoded polygon has inconsistent symmetry data."
+        );
+    }
+
+    std::vector<Point> unfolded;
+    unfolded.reserve(n);
+
+    // Each part ends on an axis; a vertex lying there starts the next part
+    std::vector<Point> part = encoded.points;
+    bool starts_at_vertex = encoded.start % 2 == 0;
+    bool ends_at_vertex = (encoded.start + half_edges) % 2 == 0;
+
+    Ray previous = encoded.axis;
+    Ray current = second_axis(encoded);
+
+    for (std::size_t j = 0; j < 2 * k; ++j)
+    {
+        if (j > 0)
+        {
+            // The next part is the mirror image of this one across
+            // the axis they share, traversed backwards
+            auto mirror = reflection(current);
+            for (auto &p : part)
+                p = mirror * p;
+            std::reverse(part.begin(), part.end());
+            std::swap(starts_at_vertex, ends_at_vertex);
+
+            Point a = mirror * previous.start_point;
+            Point b = mirror * (previous.start_point + previous.direction);
+            previous = current;
+            current = Ray(a, b - a);
+        }
+
+        unfolded.insert(unfolded.end(), part.begin(),
+                        ends_at_vertex ? part.end() - 1 : part.end());
+    }
+
+    if (unfolded.size() != n)
+    {
+        throw std::invalid_argument(
+            "Encoded polygon has inconsistent symmetry data."
+        );
+    }
+
+    // The unfolded vertices start at the first axis; restore the
+    // original first vertex
+    std::rotate(unfolded.begin(),
+                unfolded.begin() + (n - (encoded.start + 1) / 2 % n) % n,
+                unfolded.end());
+
+    return ConvexPolygon(unfolded.begin(), unfolded.end(), alloc);
+}
+
+void SymmetryCodec::write(const Encoded &encoded, std::ostream &output)
+{
+    write_raw(output, encoded.vertex_count);
+    write_raw(output, encoded.order);
+    write_raw(output, encoded.start);
+    write_raw(output, (std::uint32_t)encoded.points.size());
+
+    if (encoded.order != 0)
+    {
+        const double packed[4] = {
+            encoded.axis.start_point.x,
+            encoded.axis.start_point.y,
+            encoded.axis.direction.x,
+            encoded.axis.direction.y,
+        };
+        write_raw(output, packed);
+    }
+
+    for (const auto &p : encoded.points)
+    {
+        const double packed[2] = {p.x, p.y};
+        write_raw(output, packed);
+    }
+}
+
+SymmetryCodec::Encoded SymmetryCodec::read(std::istream &input)
+{
+    Encoded encoded;
+    encoded.vertex_count = read_raw<std::uint32_t>(input);
+    encoded.order = read_raw<std::uint32_t>(input);
+    encoded.start = read_raw<std::uint32_t>(input);
+    auto count = read_raw<std::uint32_t>(input);
+
+    if (encoded.order != 0)
+    {
+        auto packed = read_raw<std::array<double, 4>>(input);
+        encoded.axis = Ray(
+            Point(packed[0], packed[1]), Vector(packed[2], packed[3]));
+    }
+
+    encoded.points.reserve(std::min<std::uint32_t>(count, 1 << 20));
+    for (std::uint32_t i = 0; i < count; ++i)
+    {
+        auto packed = read_raw<std::array<double, 2>>(input);
+        encoded.points.emplace_back(packed[0], packed[1]);
+    }
+
+    return encoded;
+}
+
+std::size_t SymmetryCodec::written_size(const Encoded &encoded)
+{
+    // Four 32-bit header fields, the axis and the points
+    return 4 * sizeof(std::uint32_t)
+        + (encoded.order != 0 ? 4 * sizeof(double) : 0)
+        + encoded.points.size() * 2 * sizeof(double);
+}
+
+Ray SymmetryCodec::second_axis(const Encoded &encoded)
+{
+    const std::size_t k = encoded.order;
+    const std::size_t end = encoded.start + encoded.vertex_count / k;
+
+    // A single axis bounds both ends of the stored half
+    if (k == 1)
+        return encoded.axis;
+
+    const Point &centre = encoded.axis.start_point;
+    const Vector last = encoded.points.back() - centre;
+
+    // The part ends at a vertex lying on the second axis
+    if (end % 2 == 0)
+        return Ray(centre, last);
+
+    // Otherwise the axis is the first one turned by pi / k towards 
+    // the stored vertices
+    double side = encoded.axis.direction.cross_product(last);
+    if (side == 0)
+    {
+        throw std::invalid_argument(
+            "Encoded polygon has inconsistent symmetry data."
+        );
+    }
+
+    double angle = std::copysign(std::acos(-1.0) / k, side);
+    const Vector &d = encoded.axis.direction;
+    return Ray(centre, Vector(
+        d.x * std::cos(angle) - d.y * std::sin(angle),
+        d.x * std::sin(angle) + d.y * std::cos(angle)));
+}
+
+std::uint32_t SymmetryCodec::vertices_between(std::uint32_t first,
+                                              std::uint32_t last)
+{
+    // Vertices sit at the even positions
+    return last / 2 - (first + 1) / 2 + 1;
+}
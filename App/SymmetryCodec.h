@@ -0,0 +1,101 @@
+#pragma once
+
+#include "ConvexPolygon.h"
+#include "Point.h"
+#include "Ray.h"
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+/**
+ * @class SymmetryCodec
+ * @brief Compact storage for symmetric polygons. A polygon with k axes
+ *        of symmetry is stored as the part of its boundary between two
+ *        neighbouring axes, 1/(2k) of the vertices, and rebuilt by
+ *        reflecting that part across the axes in turn. Polygons without
+ *        symmetry, and those the compact form would not make smaller,
+ *        are stored whole.
+ */
+class SymmetryCodec
+{
+public:
+    /**
+     * @struct Encoded
+     * @brief A polygon in compact form. Boundary positions are counted
+     *        in half edges: position 2i is vertex i and position 2i + 1
+     *        is the midpoint of the edge that follows it.
+     */
+    struct Encoded
+    {
+        std::uint32_t vertex_count = 0; ///< Vertices of the whole polygon.
+        std::uint32_t order = 0; ///< Number of axes, 0 for full storage.
+        std::uint32_t start = 0; ///< Position where the first axis meets the boundary.
+        /// The first axis bounding the stored part. With several axes it 
+        /// starts at their common centre and points towards the start 
+        /// position; the second axis is derived from it and the order.
+        Ray axis = Ray(Point(0, 0), Vector(0, 0));
+        std::vector<Point> points; ///< Vertices of the stored part.
+    };
+
+    /**
+     * @brief Constructs a codec.
+     * @param EPS Tolerance for the search of the axes of symmetry.
+     */
+    explicit SymmetryCodec(double EPS = EPS_DEFAULT);
+
+    /**
+     * @brief Encodes a polygon, using its axes of symmetry if it has any.
+     * @param polygon The polygon to encode.
+     * @return The encoded polygon.
+     */
+    Encoded encode(const ConvexPolygon &polygon) const;
+
+    /**
+     * @brief Rebuilds a polygon, with its vertices in the original order.
+     * @param encoded The encoded polygon.
+     * @param alloc Allocator used for the vertex storage.
+     * @return The decoded polygon.
+     * @throws std::invalid_argument if the encoding is inconsistent or
+     *         does not describe a convex polygon.
+     */
+    ConvexPolygon decode(const Encoded &encoded,
+                         const ConvexPolygon::allocator_type &alloc = {}) const;
+
+    /**
+     * @brief Writes an encoded polygon in binary form.
+     * @param encoded The encoded polygon.
+     * @param output Stream to write to.
+     */
+    static void write(const Encoded &encoded, std::ostream &output);
+
+    /**
+     * @brief Reads an encoded polygon written by write().
+     * @param input Stream to read from.
+     * @return The encoded polygon.
+     * @throws std::runtime_error if the data is truncated.
+     */
+    static Encoded read(std::istream &input);
+
+private:
+    /**
+     * @brief Returns the number of bytes write() produces for a polygon.
+     */
+    static std::size_t written_size(const Encoded &encoded);
+
+    /**
+     * @brief Derives the second axis bounding the stored part.
+     * @throws std::invalid_argument if the stored part does not fix it.
+     */
+    static Ray second_axis(const Encoded &encoded);
+
+    /**
+     * @brief Returns the number of vertices between two boundary
+     *        positions, both included.
+     */
+    static std::uint32_t vertices_between(std::uint32_t first,
+                                          std::uint32_t last);
+
+    double EPS;
+};
@@ -0,0 +1,69 @@
+#include "TextAxisWriter.h"
+
+TextAxisWriter::TextAxisWriter(std::ostream &output)
+    : TextAxisWriter(output, output) {}
+
+TextAxisWriter::TextAxisWriter(std::ostream &output, std::ostream &errors)
+    : AxisWriter(output), output(output), errors(errors) {}
+
+void TextAxisWriter::format_axes(
+    std::string_view label, const Ray *axes, std::size_t count)
+{
+    put_label(label);
+
+    if (count == 0)
+    {
+        put("The polygon is non-symmetric.\n");
+        return;
+    }
+
+    put("Axes of symmetry:\n");
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const Ray &axis = axes[i];
+        put_number(axis.start_point.x, PRECISION);
+        put(' ');
+        put_number(axis.start_point.y, PRECISION);
+        put(" - ");
+        put_number(axis.start_point.x + axis.direction.x, PRECISION);
+        put(' ');
+        put_number(axis.start_point.y + axis.direction.y, PRECISION);
+        put('\n');
+    }
+}
+
+void TextAxisWriter::format_symmetry(std::string_view label, bool symmetric)
+{
+    put_label(label);
+    put(symmetric
+        ? "The polygon is symmetric.\n"
+        : "The polygon is non-symmetric.\n");
+}
+
+void TextAxisWriter::format_error(
+    std::string_view label, std::string_view message)
+{
+    put_label(label);
+
+    if (&errors == &output)
+    {
+        put("Error: ");
+        put(message);
+        put('\n');
+    }
+    else
+    {
+        // Keep the records written so far ahead of the message
+        flush();
+        errors << "Error: " << message << std::endl;
+    }
+}
+
+void TextAxisWriter::put_label(std::string_view label)
+{
+    if (!label.empty())
+    {
+        put(label);
+        put(":\n");
+    }
+}
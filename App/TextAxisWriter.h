@@ -0,0 +1,46 @@
+#pragma once
+
+#include "AxisWriter.h"
+
+/**
+ * @class TextAxisWriter
+ * @brief Writes the axes of symmetry as text, one axis per line given by 
+ *        two of its points: "x1 y1 - x2 y2".
+ */
+class TextAxisWriter : public AxisWriter
+{
+public:
+    /**
+     * @brief Constructs a writer that puts the errors among the records.
+     * @param output The stream to write to.
+     */
+    explicit TextAxisWriter(std::ostream &output);
+
+    /**
+     * @brief Constructs a writer with a separate stream for the errors.
+     * @param output The stream to write the records to.
+     * @param errors The stream to write the error messages to.
+     */
+    TextAxisWriter(std::ostream &output, std::ostream &errors);
+
+protected:
+    void format_axes(
+        std::string_view label, const Ray *axes, std::size_t count) override;
+
+    void format_symmetry(std::string_view label, bool symmetric) override;
+
+    void format_error(
+        std::string_view label, std::string_view message) override;
+
+private:
+    /**
+     * @brief Appends the label line, if the label is not empty.
+     * @param label Name of the polygon.
+     */
+    void put_label(std::string_view label);
+
+    std::ostream &output;
+    std::ostream &errors;
+
+    static constexpr int PRECISION = 6; ///< Default precision of std::ostream.
+};
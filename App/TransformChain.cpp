@@ -0,0 +1,80 @@
+#include "TransformChain.h"
+
+TransformChain &TransformChain::then(const TransformMatrix &matrix)
+{
+    steps.push_back(matrix);
+    return *this;
+}
+
+TransformChain &TransformChain::translate(double dx, double dy)
+{
+    TransformMatrix matrix;
+    matrix.set_translation(dx, dy);
+    return then(matrix);
+}
+
+TransformChain &TransformChain::rotate(double angle)
+{
+    TransformMatrix matrix;
+    matrix.set_rotation(angle);
+    return then(matrix);
+}
+
+TransformChain &TransformChain::scale(double sx, double sy)
+{
+    TransformMatrix matrix;
+    matrix.set_scaling(sx, sy);
+    return then(matrix);
+}
+
+TransformMatrix TransformChain::fold() const
+{
+    const Affine m = fold_affine();
+    const Point origin(m.c, m.f);
+
+    return TransformMatrix(
+        Ray(origin, Vector(m.a, m.d)),
+        Ray(origin, Vector(m.b, m.e)));
+}
+
+Point TransformChain::operator*(const Point &point) const
+{
+    const Affine m = fold_affine();
+    return Point(
+        m.a * point.x + m.b * point.y + m.c,
+        m.d * point.x + m.e * point.y + m.f);
+}
+
+void TransformChain::apply(Point *points, std::size_t count) const
+{
+    const Affine m = fold_affine();
+
+    // Plain loop over the coordinates, so that the compiler vectorizes it
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const double x = points[i].x;
+        const double y = points[i].y;
+        points[i].x = m.a * x + m.b * y + m.c;
+        points[i].y = m.d * x + m.e * y + m.f;
+    }
+}
+
+TransformChain::Affine TransformChain::fold_affine() const
+{
+    Affine m = {1, 0, 0, 0, 1, 0};
+
+    // Every step is affine, so the last row of the product is always 
+    // (0, 0, 1) and only the first two rows have to be multiplied
+    for (const auto &step : steps)
+    {
+        const double a = step.at(0, 0), b = step.at(0, 1), c = step.at(0, 2);
+        const double d = step.at(1, 0), e = step.at(1, 1), f = step.at(1, 2);
+
+        m = {
+            a * m.a + b * m.d, a * m.b + b * m.e, a * m.c + b * m.f + c,
+            d * m.a + e * m.d, d * m.b + e * m.e, d * m.c + e * m.f + f,
+        };
+    }
+
+    return m;
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include "Point.h"
+#include "TransformMatrix.h"
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @class TransformChain
+ * @brief A sequence of 2D transformations that is evaluated lazily.
+ *        The steps are only recorded when the chain is built; applying 
+ *        the chain folds them into a single affine matrix and transforms 
+ *        every point in one pass.
+ */
+class TransformChain
+{
+public:
+    /**
+     * @brief Constructs an empty chain, equivalent to the identity.
+     */
+    TransformChain() = default;
+
+    /**
+     * @brief Appends a transformation applied after the previous steps.
+     * @param matrix The transformation matrix.
+     * @return This chain.
+     */
+    TransformChain &then(const TransformMatrix &matrix);
+
+    /**
+     * @brief Appends a translation.
+     * @param dx Translation in the x direction.
+     * @param dy Translation in the y direction.
+     * @return This chain.
+     */
+    TransformChain &translate(double dx, double dy);
+
+    /**
+     * @brief Appends a rotation around the origin.
+     * @param angle Rotation angle in radians.
+     * @return This chain.
+     */
+    TransformChain &rotate(double angle);
+
+    /**
+     * @brief Appends a scaling relative to the origin.
+     * @param sx Scaling factor in the x direction.
+     * @param sy Scaling factor in the y direction.
+     * @return This chain.
+     */
+    TransformChain &scale(double sx, double sy);
+
+    /**
+     * @brief Folds the chain into a single matrix.
+     * @return The matrix equivalent to applying all the steps in order.
+     */
+    TransformMatrix fold() const;
+
+    /**
+     * @brief Transforms a single point.
+     * @param point The point to transform.
+     * @return The transformed point.
+     */
+    Point operator*(const Point &point) const;
+
+    /**
+     * @brief Transforms a range of points.
+     * @tparam InputIt Iterator type for the input points.
+     * @tparam OutputIt Iterator type for the transformed points.
+     * @param first Iterator to the first point.
+     * @param last Iterator to the past-the-end point.
+     * @param out Iterator to write the transformed points to.
+     * @return Iterator past the last transformed point.
+     */
+    template <typename InputIt, typename OutputIt>
+    OutputIt apply(InputIt first, InputIt last, OutputIt out) const;
+
+    /**
+     * @brief Transforms a contiguous array of points in place.
+     * @param points Pointer to the first point.
+     * @param count Number of points.
+     */
+    void apply(Point *points, std::size_t count) const;
+
+private:
+    /**
+     * @struct Affine
+     * @brief The first two rows of an affine matrix:
+     *        x' = a * x + b * y + c, y' = d * x + e * y + f.
+     */
+    struct Affine
+    {
+        double a, b, c, d, e, f;
+    };
+
+    /**
+     * @brief Folds the steps into the coefficients of one affine matrix.
+     * @return The folded coefficients.
+     */
+    Affine fold_affine() const;
+
+    std::vector<TransformMatrix> steps; ///< Steps in the order of application.
+};
+
+template <typename InputIt, typename OutputIt>
+OutputIt TransformChain::apply(InputIt first, InputIt last, OutputIt out) const
+{
+    const Affine m = fold_affine();
+
+    for (; first != last; ++first, ++out)
+    {
+        const Point &p = *first;
+        *out = Point(
+            m.a * p.x + m.b * p.y + m.c,
+            m.d * p.x + m.e * p.y + m.f);
+    }
+
+    return out;
+}
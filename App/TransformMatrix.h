@@ -65,6 +65,14 @@ public:
      */
     TransformMatrix inverse() const;
 
+    /**
+     * @brief Returns an element of this matrix.
+     * @param row Row index, from 0 to 2.
+     * @param column Column index, from 0 to 2.
+     * @return The element value.
+     */
+    double at(int row, int column) const { return data[row][column]; }
+
 private:
     /**
      * @brief Computes the determinant of this matrix.
@@ -0,0 +1,217 @@
+#include "VertexSimplifier.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+    double distance(const Point &a, const Point &b)
+    {
+        Vector d = b - a;
+        return std::sqrt(d.dot_product(d));
+    }
+
+    /**
+     * @brief Returns the distance of v from the line through a and b, or 
+     *        infinity if v does not lie between a and b along that line.
+     */
+    double deviation(const Point &a, const Point &v, const Point &b)
+    {
+        Vector ab = b - a;
+        Vector av = v - a;
+        Vector vb = b - v;
+
+        if (av.dot_product(vb) < 0)
+            return INFINITY;
+
+        double length = std::sqrt(ab.dot_product(ab));
+        return std::abs(ab.cross_product(av)) / length;
+    }
+}
+
+VertexSimplifier::VertexSimplifier(double EPS, double tolerance)
+    : EPS(EPS), limit(std::max(EPS, tolerance)) {}
+
+bool VertexSimplifier::is_exact() const
+{
+    return limit <= EPS;
+}
+
+VertexSimplifier VertexSimplifier::exact() const
+{
+    return VertexSimplifier(EPS);
+}
+
+std::size_t VertexSimplifier::simplify(Point *points, std::size_t count) const
+{
+    std::vector<double> error;
+    const auto merged = merge(points, count, error);
+    if (is_exact())
+        return merged;
+    return decimate(points, merged, error);
+}
+
+std::size_t VertexSimplifier::merge(
+    Point *points, std::size_t count, std::vector<double> &error) const
+{
+    // dev[i] bounds the distance of the vertices removed between 
+    // the kept vertices i - 1 and i from the segment joining them
+    std::vector<double> dev(count, 0.0);
+    std::size_t k = 0;
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const Point p = points[i];
+
+        if (k > 0 && distance(points[k - 1], p) <= EPS)
+            continue;
+
+        double carried = 0;
+        while (k >= 2)
+        {
+            double bound =
+                deviation(points[k - 2], points[k - 1], p)
+                + std::max(dev[k - 1], carried);
+
+            if (bound > EPS)
+                break;
+
+            carried = bound;
+            --k;
+        }
+
+        points[k] = p;
+        dev[k] = carried;
+        ++k;
+    }
+
+    while (k > 1 && distance(points[k - 1], points[0]) <= EPS)
+        --k;
+
+    // Remove the redundant vertices around the closing edge, 
+    // from its end and from its start
+    std::size_t first = 0;
+    double closing = 0;
+    for (bool changed = true; changed && k - first >= 3;)
+    {
+        changed = false;
+
+        double bound =
+            deviation(points[k - 2], points[k - 1], points[first])
+            + std::max(dev[k - 1], closing);
+        if (bound <= EPS)
+        {
+            closing = bound;
+            --k;
+            changed = true;
+            continue;
+        }
+
+        bound =
+            deviation(points[k - 1], points[first], points[first + 1])
+            + std::max(closing, dev[first + 1]);
+        if (bound <= EPS)
+        {
+            closing = bound;
+            ++first;
+            changed = true;
+        }
+    }
+
+    std::copy(points + first, points + k, points);
+
+    // error[i] bounds the removed vertices on the edge from i to i + 1
+    error.assign(k - first, closing);
+    for (std::size_t i = first; i + 1 < k; ++i)
+        error[i - first] = dev[i + 1];
+
+    return k - first;
+}
+
+std::size_t VertexSimplifier::decimate(
+    Point *points, std::size_t count, std::vector<double> &error) const
+{
+    std::vector<double> cost(count);
+    std::vector<bool> anchor(count);
+    std::vector<bool> removed(count);
+
+    while (count > 3)
+    {
+        auto prev = [count](std::size_t i)
+        {
+            return i == 0 ? count - 1 : i - 1;
+        };
+        auto next = [count](std::size_t i)
+        {
+            return i + 1 == count ? 0 : i + 1;
+        };
+
+        // Removing a vertex merges the edges on both sides of it
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            cost[i] = deviation(points[prev(i)], points[i], points[next(i)])
+                + std::max(error[prev(i)], error[i]);
+        }
+
+        // Vertices that cannot be removed, and those costing no less 
+        // than both neighbours, are kept. Both tests read the same 
+        // values forwards and backwards, so every symmetry of the 
+        // outline maps the kept vertices onto kept ones
+        std::size_t start = count;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            anchor[i] = cost[i] > limit
+                || (cost[i] + EPS >= cost[prev(i)]
+                    && cost[i] + EPS >= cost[next(i)]);
+            if (anchor[i] && start == count)
+                start = i;
+        }
+
+        // Without a kept vertex, e.g. on a regular polygon, no 
+        // choice of vertices is preserved by every symmetry
+        if (start == count)
+            break;
+
+        // Every run of removable vertices between kept ones loses 
+        // every other vertex, in a pattern that reads the same from 
+        // both ends of the run
+        std::size_t removals = 0;
+        std::fill(removed.begin(), removed.end(), false);
+        for (std::size_t offset = 1; offset <= count;)
+        {
+            const auto begin = offset;
+            while (offset < count && !anchor[(start + offset) % count])
+                ++offset;
+
+            const auto length = offset - begin;
+            for (std::size_t t = 0; t < length; ++t)
+            {
+                const auto from_end = std::min(t, length - 1 - t);
+                if (from_end % 2 == 0
+                    && !(length % 2 == 0 && from_end == length / 2 - 1))
+                {
+                    removed[(start + begin + t) % count] = true;
+                    ++removals;
+                }
+            }
+            ++offset;
+        }
+
+        if (removals == 0 || count - removals < 3)
+            break;
+
+        std::size_t k = 0;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (removed[i])
+                continue;
+            points[k] = points[i];
+            error[k] = removed[next(i)] ? cost[next(i)] : error[i];
+            ++k;
+        }
+        count = k;
+    }
+
+    return count;
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "Point.h"
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @class VertexSimplifier
+ * @brief Removes redundant vertices from the outline of a polygon in one 
+ *        pass: near-duplicate vertices and vertices lying on the line 
+ *        through their neighbours. With a tolerance, nearly collinear 
+ *        vertices are then removed in rounds, as long as every removed 
+ *        vertex stays within the tolerance of the simplified outline. 
+ *        Each round picks the vertices from their neighbourhoods alone, 
+ *        the same way in both directions, so the rounds keep the axes 
+ *        of symmetry of the outline up to rounding; axes found on the 
+ *        result are still checked against the outline simplified with 
+ *        exact() only.
+ */
+class VertexSimplifier
+{
+public:
+    /**
+     * @brief Constructs a simplifier.
+     * @param EPS Distance below which vertices are considered equal or 
+     *            collinear.
+     * @param tolerance Maximal distance of a removed vertex from the 
+     *                  simplified outline, ignored when less than EPS.
+     */
+    explicit VertexSimplifier(double EPS = EPS_DEFAULT, double tolerance = 0);
+
+    /**
+     * @brief Simplifies a closed outline in place.
+     * @param points Pointer to the first vertex.
+     * @param count Number of vertices.
+     * @return Number of vertices left at the beginning of the array.
+     */
+    std::size_t simplify(Point *points, std::size_t count) const;
+
+    /**
+     * @brief Simplifies a closed outline stored in a vector in place.
+     * @tparam Container Vector-like container of points.
+     * @param points The vertices, shrunk to the remaining ones.
+     */
+    template <typename Container>
+    void simplify(Container &points) const
+    {
+        points.erase(
+            points.begin() + simplify(points.data(), points.size()),
+            points.end());
+    }
+
+    /**
+     * @brief Checks if only the duplicate and collinear vertices are 
+     *        removed, which keeps every axis of symmetry of the outline.
+     * @return True if the tolerance does not exceed EPS.
+     */
+    bool is_exact() const;
+
+    /**
+     * @brief Returns the simplifier removing only the duplicate and 
+     *        collinear vertices.
+     * @return A simplifier with the same EPS and no tolerance.
+     */
+    VertexSimplifier exact() const;
+
+private:
+    /**
+     * @brief Removes the duplicate and collinear vertices.
+     * @param points Pointer to the first vertex.
+     * @param count Number of vertices.
+     * @param error Receives, for every remaining vertex, a bound on the 
+     *              distance of the vertices removed from its outgoing edge.
+     * @return Number of vertices left at the beginning of the array.
+     */
+    std::size_t merge(Point *points, std::size_t count,
+                      std::vector<double> &error) const;
+
+    /**
+     * @brief Removes nearly collinear vertices within the tolerance, in 
+     *        rounds that never remove two neighbouring vertices.
+     * @param points Pointer to the first vertex.
+     * @param count Number of vertices.
+     * @param error Error bound of the outgoing edge of every vertex, 
+     *              updated as the edges are merged.
+     * @return Number of vertices left at the beginning of the array.
+     */
+    std::size_t decimate(Point *points, std::size_t count,
+                         std::vector<double> &error) const;
+
+    double EPS;
+    double limit; ///< Maximal deviation of the simplified outline.
+};
@@ -0,0 +1,138 @@
+#include "WorkStealingPool.h"
+
+#include <algorithm>
+
+namespace
+{
+    // Pool and worker index of the calling thread, if it is a worker
+    thread_local const WorkStealingPool *current_pool = nullptr;
+    thread_local std::size_t current_index = 0;
+}
+
+WorkStealingPool::WorkStealingPool(std::size_t threads)
+{
+    if (threads == 0)
+        threads = std::max(std::thread::hardware_concurrency(), 1u);
+
+    for (std::size_t i = 0; i < threads; ++i)
+        workers.push_back(std::make_unique<Worker>());
+
+    for (std::size_t i = 0; i < threads; ++i)
+        this->threads.emplace_back(&WorkStealingPool::run, this, i);
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+    wait();
+
+    {
+        std::lock_guard<std::mutex> lock(state_mutex);
+        stopping = true;
+    }
+    work_available.notify_all();
+
+    for (auto &thread : threads)
+        thread.join();
+}
+
+void WorkStealingPool::submit(Task task)
+{
+    const std::size_t index = current_pool == this
+        ? current_index
+        : next.fetch_add(1, std::memory_order_relaxed) % workers.size();
+
+    // The task is counted before it becomes visible, under the lock 
+    // taken by find_task(), so a thief taking it at once cannot 
+    // decrement queued below the number of tasks in the deques
+    pending.fetch_add(1, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(workers[index]->mutex);
+        queued.fetch_add(1, std::memory_order_release);
+        workers[index]->tasks.push_back(std::move(task));
+    }
+
+    // Taking the lock orders the notification after the check
+    // of a worker that is about to sleep
+    {
+        std::lock_guard<std::mutex> lock(state_mutex);
+    }
+    work_available.notify_one();
+}
+
+void WorkStealingPool::wait()
+{
+    std::unique_lock<std::mutex> lock(state_mutex);
+    all_done.wait(lock, [this]
+    {
+        return pending.load(std::memory_order_acquire) == 0;
+    });
+}
+
+void WorkStealingPool::run(std::size_t index)
+{
+    current_pool = this;
+    current_index = index;
+
+    Task task;
+    for (;;)
+    {
+        if (find_task(index, task))
+        {
+            task();
+            task = nullptr;
+            finish_task();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(state_mutex);
+        work_available.wait(lock, [this]
+        {
+            return stopping || queued.load(std::memory_order_acquire) > 0;
+        });
+
+        if (stopping && queued.load(std::memory_order_acquire) == 0)
+            return;
+    }
+}
+
+bool WorkStealingPool::find_task(std::size_t index, Task &task)
+{
+    {
+        Worker &own = *workers[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty())
+        {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            queued.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    const std::size_t count = workers.size();
+    for (std::size_t offset = 1; offset < count; ++offset)
+    {
+        Worker &victim = *workers[(index + offset) % count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty())
+        {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            queued.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void WorkStealingPool::finish_task()
+{
+    if (pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        {
+            std::lock_guard<std::mutex> lock(state_mutex);
+        }
+        all_done.notify_all();
+    }
+}
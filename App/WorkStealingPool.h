@@ -0,0 +1,103 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class WorkStealingPool
+ * @brief Thread pool in which every worker has its own task deque.
+ *        A worker runs its newest task first and, once its deque is
+ *        empty, steals the oldest task of another worker, so that a
+ *        task which splits into many sub-tasks spreads over all threads.
+ */
+class WorkStealingPool
+{
+public:
+    using Task = std::function<void()>;
+
+    /**
+     * @brief Starts the worker threads.
+     * @param threads Number of workers, 0 for one per hardware thread.
+     */
+    explicit WorkStealingPool(std::size_t threads = 0);
+
+    WorkStealingPool(const WorkStealingPool &) = delete;
+    WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+
+    /**
+     * @brief Waits for the submitted tasks and stops the workers.
+     */
+    ~WorkStealingPool();
+
+    /**
+     * @brief Submits a task. A task submitted by a worker goes to the
+     *        deque of that worker, any other one to the workers in turn.
+     *        Tasks must not throw.
+     * @param task The task to run.
+     */
+    void submit(Task task);
+
+    /**
+     * @brief Blocks until every submitted task, including the tasks
+     *        submitted by running tasks, has finished. Must not be
+     *        called from a task.
+     */
+    void wait();
+
+    /**
+     * @brief Returns the number of worker threads.
+     * @return The number of workers.
+     */
+    std::size_t thread_count() const { return threads.size(); }
+
+private:
+    /**
+     * @struct Worker
+     * @brief Task deque of one worker. The owner pushes and pops at
+     *        the back, thieves take from the front.
+     */
+    struct Worker
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    /**
+     * @brief Runs tasks on a worker thread until the pool is stopped.
+     * @param index Index of the worker.
+     */
+    void run(std::size_t index);
+
+    /**
+     * @brief Takes the newest task of a worker's own deque, or else the
+     *        oldest task of another worker.
+     * @param index Index of the worker looking for a task.
+     * @param task Receives the task.
+     * @return True if a task was found.
+     */
+    bool find_task(std::size_t index, Task &task);
+
+    /**
+     * @brief Marks a task as finished, waking wait() after the last one.
+     */
+    void finish_task();
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::vector<std::thread> threads;
+
+    std::atomic<std::size_t> queued{0};  ///< Tasks waiting in the deques.
+    std::atomic<std::size_t> pending{0}; ///< Tasks submitted, not finished.
+    std::atomic<std::size_t> next{0};    ///< Worker for the next outside task.
+
+    std::mutex state_mutex;
+    std::condition_variable work_available;
+    std::condition_variable all_done;
+    bool stopping = false;
+};
@@ -1,19 +1,43 @@
 #include <iostream>
 #include <fstream>
+#include <memory_resource>
+#include <optional>
 #include <sstream>
 #include <vector>
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
+#include "AxisWriter.h"
+#include "BatchArena.h"
 #include "ConvexPolygon.h"
+#include "ShardedRunner.h"
+#include "StreamPipeline.h"
+#include "VertexSimplifier.h"
+
+/**
+ * @struct Analysis
+ * @brief What is done with every polygon read from a file.
+ */
+struct Analysis
+{
+    std::optional<VertexSimplifier> simplifier; ///< Simplification of the outline.
+    bool check_only = false; ///< Only check whether the polygon is symmetric.
+};
 
 /**
  * @brief Reads points from a text file.
  * @param filename The name of the text file.
+ * @param resource Memory resource for the returned vector.
  * @return A vector of points read from the file.
  * @throws std::runtime_error if the file cannot be opened or if the point 
  *         format is invalid.
  */
-std::vector<Point> read_points_from_file(const std::string &filename)
+std::pmr::vector<Point> read_points_from_file(
+    const std::string &filename,
+    std::pmr::memory_resource *resource)
 {
-    std::vector<Point> points;
+    std::pmr::vector<Point> points(resource);
     std::ifstream file(filename);
 
     if (!file.is_open())
@@ -37,53 +61,339 @@ std::vector<Point> read_points_from_file(const std::string &filename)
 }
 
 /**
- * @brief Main function for the console application.
- * @param argc Number of command line arguments.
- * @param argv Command line arguments.
+ * @brief Reads a polygon from a text file and writes its axes of symmetry, 
+ *        or only whether it is symmetric.
+ * @param filename The name of the text file.
+ * @param label Name of the polygon in the output.
+ * @param writer Writer for the axes.
+ * @param analysis Simplification and kind of the result.
+ * @param resource Memory resource for all the intermediate data.
+ * @throws std::runtime_error if the file cannot be read.
+ * @throws std::invalid_argument if the points do not form a convex polygon.
+ */
+void write_axes_of_symmetry(
+    const std::string &filename,
+    const std::string &label,
+    AxisWriter &writer,
+    const Analysis &analysis,
+    std::pmr::memory_resource *resource)
+{
+    std::pmr::vector<Point> points =
+        read_points_from_file(filename, resource);
+
+    ConvexPolygon polygon = analysis.simplifier
+        ? ConvexPolygon(
+            points.begin(), points.end(), *analysis.simplifier, resource)
+        : ConvexPolygon(points.begin(), points.end(), resource);
+
+    // The axes found after a simplification with a tolerance are 
+    // checked against the outline with only the exact merges
+    std::optional<ConvexPolygon> original;
+    if (analysis.simplifier && !analysis.simplifier->is_exact())
+    {
+        original.emplace(ConvexPolygon(
+            points.begin(), points.end(),
+            analysis.simplifier->exact(), resource));
+    }
+
+    if (analysis.check_only)
+    {
+        // Stops at the first axis found
+        writer.write_symmetry(label, original
+            ? polygon.has_symmetry(*original)
+            : polygon.has_symmetry());
+        return;
+    }
+
+    std::pmr::vector<Ray> axes = original
+        ? polygon.find_axes_of_symmetry(*original, resource)
+        : polygon.find_axes_of_symmetry(resource);
+
+    writer.write_axes(label, axes);
+}
+
+/**
+ * @brief Finds axes of symmetry for every polygon of a stream.
+ * @param filename The name of the stream file, or "-" for the standard input.
+ * @param writer Writer for the axes.
+ * @param options Threads, queue sizes and simplification of the pipeline.
  * @return Exit status.
  */
-int main(int argc, char *argv[])
+int run_stream(
+    const std::string &filename,
+    AxisWriter &writer,
+    const StreamPipeline::Options &options)
 {
-    if (argc != 2)
+    std::ifstream file;
+    if (filename != "-")
     {
-        std::cerr << "Usage: " << argv[0]
-                  << " <filename>" << std::endl;
-        return EXIT_FAILURE;
+        file.open(filename);
+        if (!file.is_open())
+        {
+            std::cerr << "Error: Unable to open file." << std::endl;
+            return EXIT_FAILURE;
+        }
     }
 
     try
     {
-        std::vector<Point> points =
-            read_points_from_file(argv[1]);
+        StreamPipeline pipeline(
+            filename != "-" ? file : std::cin, writer, options);
 
-        ConvexPolygon polygon(points.begin(), points.end());
+        if (pipeline.run() != 0)
+            return EXIT_FAILURE;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
 
-        std::vector<Ray> axes =
-            polygon.find_axes_of_symmetry();
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Finds axes of symmetry for every file, each processed as a 
+ *        separate batch, whose memory is released at once afterwards.
+ * @param filenames The names of the text files.
+ * @param writer Writer for the axes.
+ * @param analysis Simplification and kind of the results.
+ * @return Exit status.
+ */
+int run_files(
+    const std::vector<std::string> &filenames,
+    AxisWriter &writer,
+    const Analysis &analysis)
+{
+    BatchArena &arena = BatchArena::this_thread();
+    int status = EXIT_SUCCESS;
 
-        if (axes.empty())
+    for (const auto &filename : filenames)
+    {
+        // A single polygon is printed without a label, as it always was
+        std::string label = filenames.size() > 1 ? filename : std::string();
+
+        try
+        {
+            write_axes_of_symmetry(
+                filename, label, writer, analysis, arena.resource());
+        }
+        catch (const std::exception &e)
         {
-            std::cout << "The polygon is non-symmetric." << std::endl;
+            writer.write_error(label, e.what());
+            status = EXIT_FAILURE;
         }
-        else
+
+        writer.end_batch();
+        arena.reset();
+    }
+
+    return status;
+}
+
+/**
+ * @brief Processes the files of a manifest in sharded worker processes, 
+ *        or a single shard when running as a worker.
+ * @param options Settings of the sharded run.
+ * @param worker_shard Index of the shard to process as a worker, 
+ *                     or nothing in the parent process.
+ * @param analysis Simplification and kind of the results.
+ * @return Exit status.
+ */
+int run_sharded(
+    const ShardedRunner::Options &options,
+    std::optional<std::size_t> worker_shard,
+    const Analysis &analysis)
+{
+    try
+    {
+        ShardedRunner runner(options);
+
+        if (!worker_shard)
+            return runner.run(std::cout);
+
+        return runner.run_shard(
+            *worker_shard,
+            [&analysis](const std::string &filename, AxisWriter &writer)
+            {
+                BatchArena &arena = BatchArena::this_thread();
+                try
+                {
+                    write_axes_of_symmetry(
+                        filename, filename, writer, analysis,
+                        arena.resource());
+                }
+                catch (...)
+                {
+                    arena.reset();
+                    throw;
+                }
+                arena.reset();
+            });
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}
+
+/**
+ * @brief Prints the command line syntax.
+ * @param program Name of the executable.
+ */
+void print_usage(const char *program)
+{
+    std::cerr << "Usage: " << program
+              << " [options] <filename> [<filename> ...]" << std::endl
+              << "       " << program
+              << " [options] --stream <filename|->" << std::endl
+              << "       " << program
+              << " [options] --manifest <filename> --out <directory>"
+              << std::endl
+              << "Options:" << std::endl
+              << "  --format <text|jsonl|binary>  Output format." << std::endl
+              << "  --flush                       Flush after every polygon."
+              << std::endl
+              << "  --simplify <tolerance>        Merge duplicate and collinear"
+              << std::endl
+              << "                                vertices, and nearly collinear"
+              << std::endl
+              << "                                ones within the tolerance. The"
+              << std::endl
+              << "                                axes are those of the original"
+              << std::endl
+              << "                                vertices."
+              << std::endl
+              << "  --check                       Only tell whether each polygon"
+              << std::endl
+              << "                                is symmetric."
+              << std::endl
+              << "Options of --manifest, which runs the listed files in worker"
+              << std::endl
+              << "processes and resumes an interrupted run from checkpoints:"
+              << std::endl
+              << "  --shards <count>              Shards of the manifest."
+              << std::endl
+              << "  --jobs <count>                Workers running at once."
+              << std::endl
+              << "  --retries <count>             Restarts of a failed worker."
+              << std::endl
+              << "  --checkpoint-interval <count> Polygons between checkpoints."
+              << std::endl;
+}
+
+/**
+ * @brief Main function for the console application.
+ *        Every file given on the command line is processed as a separate 
+ *        batch. With --stream, a single file holding many polygons 
+ *        separated by blank lines is processed by a concurrent pipeline.
+ *        With --manifest, the files listed in the manifest are processed 
+ *        by worker processes, which run this executable with --shard-worker.
+ * @param argc Number of command line arguments.
+ * @param argv Command line arguments.
+ * @return Exit status.
+ */
+int main(int argc, char *argv[])
+{
+    OutputFormat format = OutputFormat::Text;
+    bool flush_each_record = false;
+    bool stream = false;
+    Analysis analysis;
+    std::vector<std::string> filenames;
+    ShardedRunner::Options sharding;
+    std::optional<std::size_t> worker_shard;
+
+    sharding.executable = argv[0];
+
+    try
+    {
+        for (int i = 1; i < argc; ++i)
         {
-            std::cout << "Axes of symmetry:" << std::endl;
-            for (const auto &axis : axes)
+            std::string arg = argv[i];
+
+            if (arg == "--format" && i + 1 < argc)
             {
-                std::cout
-                    << axis.start_point.x << ' '
-                    << axis.start_point.y << ' '
-                    << "- "
-                    << axis.start_point.x + axis.direction.x << ' '
-                    << axis.start_point.y + axis.direction.y << std::endl;
+                format = parse_output_format(argv[++i]);
+                sharding.worker_arguments.insert(
+                    sharding.worker_arguments.end(), {arg, argv[i]});
             }
+            else if (arg == "--flush")
+                flush_each_record = true;
+            else if (arg == "--simplify" && i + 1 < argc)
+            {
+                analysis.simplifier.emplace(
+                    EPS_DEFAULT, std::stod(argv[++i]));
+                sharding.worker_arguments.insert(
+                    sharding.worker_arguments.end(), {arg, argv[i]});
+            }
+            else if (arg == "--check")
+            {
+                analysis.check_only = true;
+                sharding.worker_arguments.push_back(arg);
+            }
+            else if (arg == "--stream")
+                stream = true;
+            else if (arg == "--manifest" && i + 1 < argc)
+                sharding.manifest = argv[++i];
+            else if (arg == "--out" && i + 1 < argc)
+                sharding.output_dir = argv[++i];
+            else if (arg == "--shards" && i + 1 < argc)
+                sharding.shards = std::stoul(argv[++i]);
+            else if (arg == "--jobs" && i + 1 < argc)
+                sharding.jobs = std::stoul(argv[++i]);
+            else if (arg == "--retries" && i + 1 < argc)
+                sharding.retries = std::stoul(argv[++i]);
+            else if (arg == "--checkpoint-interval" && i + 1 < argc)
+                sharding.checkpoint_interval = std::stoul(argv[++i]);
+            else if (arg == "--shard-worker" && i + 1 < argc)
+                worker_shard = std::stoul(argv[++i]);
+            else
+                filenames.push_back(arg);
         }
     }
     catch (const std::exception &e)
     {
         std::cerr << "Error: " << e.what() << std::endl;
+        print_usage(argv[0]);
         return EXIT_FAILURE;
     }
 
-    return EXIT_SUCCESS;
+    bool sharded = !sharding.manifest.empty();
+
+    if (sharded
+        ? (!filenames.empty() || stream || sharding.output_dir.empty()
+           || sharding.shards == 0 || sharding.jobs == 0
+           || sharding.checkpoint_interval == 0)
+        : (filenames.empty() || (stream && filenames.size() != 1)))
+    {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    std::ios::sync_with_stdio(false);
+
+#ifdef _WIN32
+    if (format == OutputFormat::Binary)
+        _setmode(_fileno(stdout), _O_BINARY);
+#endif
+
+    if (sharded)
+    {
+        sharding.format = format;
+        return run_sharded(sharding, worker_shard, analysis);
+    }
+
+    auto writer = make_axis_writer(format, std::cout, std::cerr);
+    writer->set_flush_each_record(flush_each_record);
+
+    if (stream)
+    {
+        StreamPipeline::Options options;
+        options.simplifier = analysis.simplifier;
+        options.check_only = analysis.check_only;
+        return run_stream(filenames.front(), *writer, options);
+    }
+
+    return run_files(filenames, *writer, analysis);
 }
@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "ConvexPolygon.h"
+#include "ScalingBenchmark.h"
+
+namespace
+{
+    // Keeps the results of the timed operations alive
+    volatile std::size_t sink = 0;
+
+    /**
+     * @brief Generates a polygon with the vertices on a circle. Without
+     *        jitter the polygon is regular; with jitter the angles are
+     *        shifted by a deterministic pseudo-random amount, which keeps
+     *        the polygon convex but leaves it without symmetry.
+     */
+    std::vector<Point> circlePolygon(std::size_t n, bool jitter)
+    {
+        const double pi = std::acos(-1.0);
+        std::uint64_t state = 12345;
+
+        std::vector<Point> points;
+        points.reserve(n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            double offset = 0;
+            if (jitter)
+            {
+                state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+                offset = (double)(state >> 11) / (double)(1ULL << 53) * 0.5;
+            }
+            double angle = 2 * pi * (i + offset) / n;
+            points.emplace_back(
+                1000 * std::cos(angle), 1000 * std::sin(angle));
+        }
+        return points;
+    }
+
+    /**
+     * @brief Checks a measurement against the baseline, or records it.
+     */
+    void checkScaling(const std::string &operation,
+                      const ScalingBenchmark::Fit &measured)
+    {
+        auto &baseline = PerfBaseline::instance();
+
+        std::cout << "[ SCALING  ] " << operation
+                  << ": exponent " << measured.exponent
+                  << ", " << measured.ns_per_vertex << " ns per vertex"
+                  << std::endl;
+
+        if (baseline.recording)
+        {
+            baseline.record(operation, measured);
+            return;
+        }
+
+        auto limits = baseline.limits(operation);
+        ASSERT_TRUE(limits) << "No baseline for " << operation;
+        EXPECT_LE(measured.exponent, limits->exponent)
+            << operation << " scales worse than the baseline";
+        EXPECT_LE(measured.ns_per_vertex, limits->ns_per_vertex)
+            << operation << " is slower than the baseline";
+    }
+}
+
+/**
+ * @brief Construction validates the convexity in O(n).
+ */
+TEST(ConvexPolygonPerf, Construction)
+{
+    auto fit = ScalingBenchmark().measure(
+        ScalingBenchmark::powers_of_two(12, 17), [](std::size_t n)
+    {
+        auto points = circlePolygon(n, true);
+        return [points]
+        {
+            ConvexPolygon polygon(points.begin(), points.end());
+            sink = sink + (polygon.end() - polygon.begin());
+        };
+    });
+    checkScaling("construction", fit);
+}
+
+/**
+ * @brief Without symmetry, centroid pruning keeps the search O(n).
+ *        Each run searches a fresh copy, so the axes are not cached.
+ */
+TEST(ConvexPolygonPerf, FindAxesAsymmetric)
+{
+    auto fit = ScalingBenchmark().measure(
+        ScalingBenchmark::powers_of_two(10, 15), [](std::size_t n)
+    {
+        auto points = circlePolygon(n, true);
+        ConvexPolygon polygon(points.begin(), points.end());
+        return [polygon]
+        {
+            ConvexPolygon copy(polygon);
+            sink = sink + copy.find_axes_of_symmetry().size();
+        };
+    });
+    checkScaling("find_axes_asymmetric", fit);
+}
+
+/**
+ * @brief A regular polygon has n axes, each verified in O(n).
+ */
+TEST(ConvexPolygonPerf, FindAxesRegular)
+{
+    auto fit = ScalingBenchmark().measure(
+        ScalingBenchmark::powers_of_two(6, 10), [](std::size_t n)
+    {
+        auto points = circlePolygon(n, false);
+        ConvexPolygon polygon(points.begin(), points.end());
+        return [polygon]
+        {
+            ConvexPolygon copy(polygon);
+            sink = sink + copy.find_axes_of_symmetry(1e-6).size();
+        };
+    });
+    checkScaling("find_axes_regular", fit);
+}
+
+/**
+ * @brief has_symmetry stops at the first axis, in O(n).
+ */
+TEST(ConvexPolygonPerf, HasSymmetryRegular)
+{
+    auto fit = ScalingBenchmark().measure(
+        ScalingBenchmark::powers_of_two(10, 15), [](std::size_t n)
+    {
+        auto points = circlePolygon(n, false);
+        ConvexPolygon polygon(points.begin(), points.end());
+        return [polygon]
+        {
+            ConvexPolygon copy(polygon);
+            sink = sink + copy.has_symmetry(1e-6);
+        };
+    });
+    checkScaling("has_symmetry_regular", fit);
+}
+
+/**
+ * @brief Congruence matching of signatures is O(n).
+ */
+TEST(ConvexPolygonPerf, Match)
+{
+    auto fit = ScalingBenchmark().measure(
+        ScalingBenchmark::powers_of_two(10, 15), [](std::size_t n)
+    {
+        auto points = circlePolygon(n, true);
+        ConvexPolygon polygon(points.begin(), points.end());
+        return [polygon]
+        {
+            ConvexPolygon a(polygon);
+            ConvexPolygon b(polygon);
+            sink = sink + a.match(b).size();
+        };
+    });
+    checkScaling("match", fit);
+}
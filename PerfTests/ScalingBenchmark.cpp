@@ -0,0 +1,156 @@
+#include "ScalingBenchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+ScalingBenchmark::ScalingBenchmark(double min_seconds, int rounds)
+    : min_seconds(min_seconds), rounds(rounds) {}
+
+ScalingBenchmark::Fit ScalingBenchmark::measure(
+    const std::vector<std::size_t> &sizes, const Prepare &prepare) const
+{
+    if (sizes.size() < 2)
+    {
+        throw std::invalid_argument(
+            "At least two sizes are needed to fit the scaling."
+        );
+    }
+
+    double sum_x = 0, sum_y = 0, sum_xx = 0, sum_xy = 0;
+    double last_seconds = 0;
+
+    for (auto n : sizes)
+    {
+        auto run = prepare(n);
+        last_seconds = seconds_per_run(run);
+
+        double x = std::log((double)n);
+        double y = std::log(last_seconds);
+        sum_x += x;
+        sum_y += y;
+        sum_xx += x * x;
+        sum_xy += x * y;
+    }
+
+    const double count = (double)sizes.size();
+    const double exponent =
+        (count * sum_xy - sum_x * sum_y) / (count * sum_xx - sum_x * sum_x);
+
+    return {exponent, last_seconds * 1e9 / sizes.back()};
+}
+
+std::vector<std::size_t> ScalingBenchmark::powers_of_two(int first, int last)
+{
+    std::vector<std::size_t> sizes;
+    for (int i = first; i <= last; ++i)
+        sizes.push_back(std::size_t(1) << i);
+    return sizes;
+}
+
+double ScalingBenchmark::seconds_per_run(
+    const std::function<void()> &run) const
+{
+    using Clock = std::chrono::steady_clock;
+
+    // The first run warms up the caches and the allocator
+    run();
+
+    double best = INFINITY;
+    for (int round = 0; round < rounds; ++round)
+    {
+        std::size_t runs = 0;
+        auto start = Clock::now();
+        std::chrono::duration<double> elapsed{0};
+        do
+        {
+            run();
+            ++runs;
+            elapsed = Clock::now() - start;
+        } while (elapsed.count() < min_seconds);
+
+        best = std::min(best, elapsed.count() / runs);
+    }
+    return best;
+}
+
+PerfBaseline &PerfBaseline::instance()
+{
+    static PerfBaseline baseline;
+    return baseline;
+}
+
+void PerfBaseline::load(const std::string &path)
+{
+    std::ifstream file(path);
+    if (!file.is_open())
+    {
+        throw std::runtime_error(
+            "Unable to open the baseline file " + path + "."
+        );
+    }
+
+    entries.clear();
+    std::string line;
+    while (std::getline(file, line))
+    {
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        std::istringstream fields(line);
+        std::string operation;
+        ScalingBenchmark::Fit fit;
+        if (!(fields >> operation >> fit.exponent >> fit.ns_per_vertex))
+        {
+            throw std::runtime_error(
+                "Invalid baseline line: " + line
+            );
+        }
+        entries[operation] = fit;
+    }
+}
+
+void PerfBaseline::save(const std::string &path) const
+{
+    std::ofstream file(path);
+    if (!file.is_open())
+    {
+        throw std::runtime_error(
+            "Unable to write the baseline file " + path + "."
+        );
+    }
+
+    // The comments are derived from the headroom, so they always 
+    // describe how the limits below were set
+    file << "# operation max_exponent max_ns_per_vertex" << std::endl;
+    file << "# Written by \"make record\": the measured exponent plus "
+         << EXPONENT_HEADROOM << "," << std::endl
+         << "# and the measured time per vertex times " << TIME_HEADROOM
+         << "." << std::endl;
+    for (const auto &[operation, fit] : entries)
+    {
+        file << operation << ' ' << fit.exponent << ' '
+             << fit.ns_per_vertex << std::endl;
+    }
+}
+
+std::optional<ScalingBenchmark::Fit> PerfBaseline::limits(
+    const std::string &operation) const
+{
+    auto entry = entries.find(operation);
+    if (entry == entries.end())
+        return std::nullopt;
+    return entry->second;
+}
+
+void PerfBaseline::record(const std::string &operation,
+                          const ScalingBenchmark::Fit &measured)
+{
+    entries[operation] = {
+        std::round((measured.exponent + EXPONENT_HEADROOM) * 100) / 100,
+        std::ceil(measured.ns_per_vertex * TIME_HEADROOM),
+    };
+}
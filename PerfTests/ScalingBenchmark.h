@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+/**
+ * @class ScalingBenchmark
+ * @brief Times an operation on inputs of growing size and fits the
+ *        empirical scaling exponent, t ~ n^k, by least squares on the
+ *        logarithms of the sizes and times.
+ */
+class ScalingBenchmark
+{
+public:
+    /**
+     * @struct Fit
+     * @brief Scaling of an operation.
+     */
+    struct Fit
+    {
+        double exponent;      ///< Fitted k of t ~ n^k.
+        double ns_per_vertex; ///< Time per vertex at the largest size.
+    };
+
+    /// Prepares the operation for a size and returns it.
+    using Prepare = std::function<std::function<void()>(std::size_t n)>;
+
+    /**
+     * @brief Constructs a benchmark.
+     * @param min_seconds Shortest time a timing round runs the operation.
+     * @param rounds Timing rounds per size; the fastest one is kept.
+     */
+    explicit ScalingBenchmark(double min_seconds = 0.02, int rounds = 3);
+
+    /**
+     * @brief Times an operation for every size and fits its scaling.
+     * @param sizes Sizes in increasing order, at least two.
+     * @param prepare Builds the input for a size outside the timing.
+     * @return The fitted scaling.
+     */
+    Fit measure(const std::vector<std::size_t> &sizes,
+                const Prepare &prepare) const;
+
+    /**
+     * @brief Returns sizes growing by powers of two.
+     * @param first Exponent of the smallest size.
+     * @param last Exponent of the largest size.
+     * @return The sizes 2^first to 2^last.
+     */
+    static std::vector<std::size_t> powers_of_two(int first, int last);
+
+private:
+    /**
+     * @brief Returns the fastest time of one run of an operation.
+     */
+    double seconds_per_run(const std::function<void()> &run) const;
+
+    double min_seconds;
+    int rounds;
+};
+
+/**
+ * @class PerfBaseline
+ * @brief Limits of the scaling of every operation, read from a text
+ *        file with one "<operation> <max exponent> <max ns per vertex>"
+ *        line per operation. Lines starting with # are comments.
+ *        In recording mode the measured values, with some headroom,
+ *        are written back instead of being checked.
+ */
+class PerfBaseline
+{
+public:
+    /**
+     * @brief Returns the baseline shared by the perf tests.
+     * @return The baseline.
+     */
+    static PerfBaseline &instance();
+
+    /**
+     * @brief Reads the limits from a file.
+     * @param path Path of the baseline file.
+     * @throws std::runtime_error if the file cannot be read or parsed.
+     */
+    void load(const std::string &path);
+
+    /**
+     * @brief Writes the limits to a file.
+     * @param path Path of the baseline file.
+     * @throws std::runtime_error if the file cannot be written.
+     */
+    void save(const std::string &path) const;
+
+    /**
+     * @brief Returns the limits of an operation.
+     * @param operation Name of the operation.
+     * @return The limits, or nothing if the baseline has none.
+     */
+    std::optional<ScalingBenchmark::Fit> limits(
+        const std::string &operation) const;
+
+    /**
+     * @brief Sets the limits of an operation from a measurement.
+     * @param operation Name of the operation.
+     * @param measured The measured scaling.
+     */
+    void record(const std::string &operation,
+                const ScalingBenchmark::Fit &measured);
+
+    bool recording = false; ///< Record measurements instead of checking.
+
+    /// Headroom added to a recorded exponent.
+    static constexpr double EXPONENT_HEADROOM = 0.3;
+
+    /// Factor applied to a recorded time per vertex.
+    static constexpr double TIME_HEADROOM = 3;
+
+private:
+    std::map<std::string, ScalingBenchmark::Fit> entries;
+};
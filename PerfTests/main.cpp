@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <string>
+
+#include "ScalingBenchmark.h"
+
+/**
+ * @brief Main function for running the performance tests.
+ *        --baseline=<file> selects the baseline, baseline.txt by default.
+ *        --record writes the measured scaling, with some headroom,
+ *        to the baseline instead of checking it.
+ * @param argc Number of command line arguments.
+ * @param argv Command line arguments.
+ * @return Exit status.
+ */
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+
+    std::string baseline_path = "baseline.txt";
+    auto &baseline = PerfBaseline::instance();
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg.rfind("--baseline=", 0) == 0)
+            baseline_path = arg.substr(std::string("--baseline=").size());
+        else if (arg == "--record")
+            baseline.recording = true;
+    }
+
+    try
+    {
+        if (!baseline.recording)
+            baseline.load(baseline_path);
+
+        int status = RUN_ALL_TESTS();
+
+        if (baseline.recording)
+            baseline.save(baseline_path);
+
+        return status;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <vector>
+
+#include "BinaryAxisWriter.h"
+#include "JsonLinesAxisWriter.h"
+#include "TextAxisWriter.h"
+
+namespace
+{
+    std::vector<Ray> make_axes()
+    {
+        return {
+            Ray(Point(0, 0), Vector(1, 1)),
+            Ray(Point(0.5, 0), Vector(0, 1)),
+        };
+    }
+}
+
+/**
+ * @brief Tests the text format, which matches the std::ostream output.
+ */
+TEST(AxisWriterTest, Text)
+{
+    std::ostringstream output;
+    {
+        TextAxisWriter writer(output);
+        writer.write_axes("", make_axes());
+        writer.write_axes("square", std::vector<Ray>());
+        writer.write_axes("", std::vector<Ray>{
+            Ray(Point(1.0 / 3, -2e-7), Vector(1234567, 0))});
+        writer.write_error("bad", "Invalid point format in file.");
+        writer.write_symmetry("", true);
+        writer.write_symmetry("", false);
+    }
+
+    EXPECT_EQ(
+        output.str(),
+        "Axes of symmetry:\n"
+        "0 0 - 1 1\n"
+        "0.5 0 - 0.5 1\n"
+        "square:\n"
+        "The polygon is non-symmetric.\n"
+        "Axes of symmetry:\n"
+        "0.333333 -2e-07 - 1.23457e+06 -2e-07\n"
+        "bad:\n"
+        "Error: Invalid point format in file.\n"
+        "The polygon is symmetric.\n"
+        "The polygon is non-symmetric.\n");
+}
+
+/**
+ * @brief Tests that nothing is written before the end of a batch.
+ */
+TEST(AxisWriterTest, FlushesAtBatchEnd)
+{
+    std::ostringstream output;
+    TextAxisWriter writer(output);
+
+    writer.write_axes("", make_axes());
+    EXPECT_TRUE(output.str().empty());
+
+    writer.end_batch();
+    EXPECT_FALSE(output.str().empty());
+}
+
+/**
+ * @brief Tests flushing after every record on request.
+ */
+TEST(AxisWriterTest, FlushEachRecord)
+{
+    std::ostringstream output;
+    TextAxisWriter writer(output);
+    writer.set_flush_each_record(true);
+
+    writer.write_axes("", std::vector<Ray>());
+    EXPECT_EQ(output.str(), "The polygon is non-symmetric.\n");
+}
+
+/**
+ * @brief Tests that the errors go to their own stream.
+ */
+TEST(AxisWriterTest, TextSeparateErrors)
+{
+    std::ostringstream output;
+    std::ostringstream errors;
+    {
+        TextAxisWriter writer(output, errors);
+        writer.write_axes("a", std::vector<Ray>());
+        writer.write_error("b", "Unable to open file.");
+    }
+
+    EXPECT_EQ(output.str(), "a:\nThe polygon is non-symmetric.\nb:\n");
+    EXPECT_EQ(errors.str(), "Error: Unable to open file.\n");
+}
+
+/**
+ * @brief Tests the JSON Lines format.
+ */
+TEST(AxisWriterTest, JsonLines)
+{
+    std::ostringstream output;
+    {
+        JsonLinesAxisWriter writer(output);
+        writer.write_axes("a\"b", make_axes());
+        writer.write_axes("", std::vector<Ray>());
+        writer.write_error("c", "bad\nline");
+        writer.write_symmetry("d", true);
+    }
+
+    EXPECT_EQ(
+        output.str(),
+        "{\"label\":\"a\\\"b\",\"axes\":[[0,0,1,1],[0.5,0,0.5,1]]}\n"
+        "{\"axes\":[]}\n"
+        "{\"label\":\"c\",\"error\":\"bad\\nline\"}\n"
+        "{\"label\":\"d\",\"symmetric\":true}\n");
+}
+
+/**
+ * @brief Tests the packed binary format.
+ */
+TEST(AxisWriterTest, Binary)
+{
+    std::ostringstream output;
+    {
+        BinaryAxisWriter writer(output);
+        writer.write_axes("ignored", make_axes());
+        writer.write_error("", "oops");
+    }
+
+    std::string data = output.str();
+    ASSERT_EQ(data.size(), 4 + 2 * 4 * 8 + 4 + 4 + 4);
+
+    std::uint32_t count;
+    std::memcpy(&count, data.data(), 4);
+    EXPECT_EQ(count, 2);
+
+    double second[4];
+    std::memcpy(second, data.data() + 4 + 32, 32);
+    EXPECT_DOUBLE_EQ(second[0], 0.5);
+    EXPECT_DOUBLE_EQ(second[1], 0);
+    EXPECT_DOUBLE_EQ(second[2], 0.5);
+    EXPECT_DOUBLE_EQ(second[3], 1);
+
+    std::uint32_t mark, length;
+    std::memcpy(&mark, data.data() + 68, 4);
+    std::memcpy(&length, data.data() + 72, 4);
+    EXPECT_EQ(mark, BinaryAxisWriter::ERROR_MARK);
+    EXPECT_EQ(length, 4);
+    EXPECT_EQ(data.substr(76), "oops");
+}
+
+/**
+ * @brief Tests parsing the output format names.
+ */
+TEST(AxisWriterTest, ParseOutputFormat)
+{
+    EXPECT_EQ(parse_output_format("text"), OutputFormat::Text);
+    EXPECT_EQ(parse_output_format("jsonl"), OutputFormat::JsonLines);
+    EXPECT_EQ(parse_output_format("binary"), OutputFormat::Binary);
+    EXPECT_THROW(parse_output_format("xml"), std::invalid_argument);
+}
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "BatchAnalyzer.h"
+#include "ConvexPolygon.h"
+
+namespace
+{
+    std::vector<Point> regularPolygon(std::size_t n)
+    {
+        std::vector<Point> points;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            double angle = 2 * std::acos(-1.0) * i / n;
+            points.emplace_back(std::cos(angle), std::sin(angle));
+        }
+        return points;
+    }
+
+    /**
+     * @brief Checks the results of a batch against the serial search.
+     */
+    void expectSerialResults(
+        const std::vector<std::vector<Point>> &polygons,
+        const std::vector<BatchAnalyzer::Result> &results, double EPS)
+    {
+        ASSERT_EQ(results.size(), polygons.size());
+
+        for (std::size_t i = 0; i < polygons.size(); ++i)
+        {
+            std::vector<Ray> expected;
+            std::string error;
+            try
+            {
+                ConvexPolygon polygon(polygons[i].begin(), polygons[i].end());
+                expected = polygon.find_axes_of_symmetry(EPS);
+            }
+            catch (const std::exception &e)
+            {
+                error = e.what();
+            }
+
+            EXPECT_EQ(results[i].error, error);
+            ASSERT_EQ(results[i].axes.size(), expected.size());
+            for (std::size_t a = 0; a < expected.size(); ++a)
+            {
+                EXPECT_TRUE(results[i].axes[a].start_point 
+                            == expected[a].start_point);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Tests that split and grouped polygons give the same results 
+ *        as the serial search.
+ */
+TEST(BatchAnalyzerTest, MatchesSerialSearch)
+{
+    std::vector<std::vector<Point>> polygons = {
+        {Point(0, 0), Point(1, 0), Point(1, 1), Point(0, 1)},
+        regularPolygon(1000),
+        {Point(0, 0), Point(1, 0), Point(0, 1), Point(1, 1)},
+        {Point(0.1, 1.0), Point(-1.0, 0.0), Point(0.0, -1.0),
+         Point(1.0, -0.5), Point(2.0, 1.0)},
+        regularPolygon(7),
+    };
+
+    // A stretched polygon, large and with two axes
+    auto ellipse = regularPolygon(2000);
+    for (auto &p : ellipse)
+        p.x *= 3;
+    polygons.push_back(ellipse);
+
+    // A large polygon that is not convex
+    auto dented = regularPolygon(3000);
+    dented[1500] = Point(0, 0);
+    polygons.push_back(dented);
+
+    BatchAnalyzer::Options options;
+    options.threads = 3;
+    options.grain = 64;
+    options.EPS = 1e-6;
+    BatchAnalyzer analyzer(options);
+
+    auto results = analyzer.analyze(polygons);
+    expectSerialResults(polygons, results, options.EPS);
+
+    EXPECT_EQ(results[1].axes.size(), 1000);
+    EXPECT_EQ(results[5].axes.size(), 2);
+    EXPECT_FALSE(results[2].error.empty());
+    EXPECT_FALSE(results[6].error.empty());
+}
+
+/**
+ * @brief Tests a batch of many small polygons and a few symmetric ones 
+ *        that fit in a grain but whose axis search does not, so that 
+ *        their candidates are split by the work they take.
+ */
+TEST(BatchAnalyzerTest, SplitsSymmetricPolygonsByWork)
+{
+    std::vector<std::vector<Point>> polygons;
+    for (std::size_t i = 0; i < 500; ++i)
+        polygons.push_back(regularPolygon(3 + i % 5));
+    polygons.push_back(regularPolygon(2000));
+    polygons.push_back(regularPolygon(3001));
+
+    BatchAnalyzer::Options options;
+    options.threads = 4;
+    options.grain = 4096;
+    options.EPS = 1e-6;
+    BatchAnalyzer analyzer(options);
+
+    auto results = analyzer.analyze(polygons);
+    expectSerialResults(polygons, results, options.EPS);
+
+    EXPECT_EQ(results[500].axes.size(), 2000);
+    EXPECT_EQ(results[501].axes.size(), 3001);
+}
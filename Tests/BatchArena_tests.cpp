@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+
+#include <memory_resource>
+#include <thread>
+#include <vector>
+
+#include "BatchArena.h"
+#include "ConvexPolygon.h"
+
+/**
+ * @brief Tests that the memory is reused after the arena is reset.
+ */
+TEST(BatchArenaTest, ResetReusesMemory)
+{
+    BatchArena arena(1024);
+
+    void *first = arena.resource()->allocate(64);
+    arena.reset();
+    void *second = arena.resource()->allocate(64);
+
+    EXPECT_EQ(first, second);
+}
+
+/**
+ * @brief Tests that the arena grows past its initial buffer.
+ */
+TEST(BatchArenaTest, GrowsPastInitialBuffer)
+{
+    BatchArena arena(64);
+
+    std::pmr::vector<Point> points(arena.resource());
+    for (int i = 0; i < 1000; ++i)
+        points.emplace_back(i, i);
+
+    EXPECT_EQ(points.size(), 1000);
+    EXPECT_DOUBLE_EQ(points.back().x, 999);
+}
+
+/**
+ * @brief Tests that each thread gets its own arena.
+ */
+TEST(BatchArenaTest, ThisThreadIsStable)
+{
+    BatchArena *main_arena = &BatchArena::this_thread();
+    EXPECT_EQ(&BatchArena::this_thread(), main_arena);
+
+    BatchArena *other_arena = nullptr;
+    std::thread other([&other_arena]
+    {
+        other_arena = &BatchArena::this_thread();
+    });
+    other.join();
+
+    EXPECT_NE(other_arena, nullptr);
+    EXPECT_NE(other_arena, main_arena);
+}
+
+/**
+ * @brief Tests a polygon and its axes allocated from an arena.
+ */
+TEST(BatchArenaTest, PolygonInArena)
+{
+    BatchArena arena;
+    {
+        std::vector<Point> points = {
+            Point(0, 0), 
+            Point(1, 0), 
+            Point(1, 1), 
+            Point(0, 1)
+        };
+        ConvexPolygon polygon(
+            points.begin(), points.end(), arena.resource());
+        auto axes = polygon.find_axes_of_symmetry(arena.resource());
+
+        EXPECT_EQ(polygon.get_allocator().resource(), arena.resource());
+        EXPECT_EQ(axes.get_allocator().resource(), arena.resource());
+        EXPECT_EQ(axes.size(), 4);
+    }
+    arena.reset();
+}
@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "BoundedQueue.h"
+
+/**
+ * @brief Tests that the values are taken in the order they were pushed.
+ */
+TEST(BoundedQueueTest, FirstInFirstOut)
+{
+    BoundedQueue<int> queue(4);
+    for (int i = 0; i < 4; ++i)
+    {
+        int value = i;
+        EXPECT_TRUE(queue.try_push(value));
+    }
+
+    int value = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        EXPECT_TRUE(queue.try_pop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(queue.try_pop(value));
+}
+
+/**
+ * @brief Tests that pushing into a full queue fails without waiting.
+ */
+TEST(BoundedQueueTest, Full)
+{
+    BoundedQueue<int> queue(2);
+    int value = 1;
+    EXPECT_TRUE(queue.try_push(value));
+    EXPECT_TRUE(queue.try_push(value));
+    EXPECT_FALSE(queue.try_push(value));
+}
+
+/**
+ * @brief Tests that a closed queue is drained before pop fails.
+ */
+TEST(BoundedQueueTest, Close)
+{
+    BoundedQueue<int> queue(4);
+    queue.push(7);
+    queue.close();
+
+    int value = 0;
+    EXPECT_TRUE(queue.pop(value));
+    EXPECT_EQ(value, 7);
+    EXPECT_FALSE(queue.pop(value));
+}
+
+/**
+ * @brief Tests that sleeping pushers and poppers are woken, which needs
+ *        waits longer than the initial spinning.
+ */
+TEST(BoundedQueueTest, SleepersAreWoken)
+{
+    BoundedQueue<int> queue(2);
+
+    int popped = 0;
+    std::thread consumer([&queue, &popped]
+    {
+        int value;
+        while (queue.pop(value))
+            popped += value;
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    for (int i = 1; i <= 5; ++i)
+        queue.push(i);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    queue.close();
+    consumer.join();
+
+    EXPECT_EQ(popped, 15);
+
+    BoundedQueue<int> full(2);
+    full.push(1);
+    full.push(2);
+    std::thread producer([&full] { full.push(3); });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    int value = 0;
+    EXPECT_TRUE(full.pop(value));
+    producer.join();
+
+    EXPECT_TRUE(full.try_pop(value));
+    EXPECT_TRUE(full.try_pop(value));
+    EXPECT_EQ(value, 3);
+}
+
+/**
+ * @brief Tests that every value is delivered exactly once with several 
+ *        producers and consumers.
+ */
+TEST(BoundedQueueTest, ManyProducersAndConsumers)
+{
+    const int producers = 4;
+    const int consumers = 4;
+    const int count = 10000;
+
+    BoundedQueue<int> queue(16);
+    std::vector<long long> sums(consumers, 0);
+    std::vector<std::thread> threads;
+
+    for (int c = 0; c < consumers; ++c)
+    {
+        threads.emplace_back(
+            [&queue, &sums, c]
+            {
+                int value;
+                while (queue.pop(value))
+                    sums[c] += value;
+            });
+    }
+
+    std::vector<std::thread> producer_threads;
+    for (int p = 0; p < producers; ++p)
+    {
+        producer_threads.emplace_back(
+            [&queue]
+            {
+                for (int i = 1; i <= count; ++i)
+                    queue.push(i);
+            });
+    }
+
+    for (auto &thread : producer_threads)
+        thread.join();
+    queue.close();
+    for (auto &thread : threads)
+        thread.join();
+
+    long long total = 0;
+    for (auto sum : sums)
+        total += sum;
+
+    EXPECT_EQ(total, (long long)producers * count * (count + 1) / 2);
+}
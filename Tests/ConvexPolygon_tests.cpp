@@ -1,6 +1,11 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cmath>
+#include <set>
+
 #include "ConvexPolygon.h"
+#include "TransformChain.h"
 
 /**
  * @brief Tests if a set of points forms a convex polygon.
@@ -132,3 +137,372 @@ TEST(ConvexPolygonTest, FindAxesOfSymmetry3)
     auto axes = polygon.find_axes_of_symmetry();
     EXPECT_EQ(axes.size(), 0);
 }
+
+/**
+ * @brief Tests that every axis of a polygon with an odd number of 
+ *        vertices is found once.
+ */
+TEST(ConvexPolygonTest, FindAxesOfSymmetryOddVertices)
+{
+    std::vector<Point> points = {
+        Point(0, 0),
+        Point(2, 0),
+        Point(1, std::sqrt(3.0)),
+    };
+    std::vector<std::pair<Point, Point>> expectedAxes = {
+        {Point(0, 0), Point(1.5, std::sqrt(3.0) / 2)},
+        {Point(2, 0), Point(0.5, std::sqrt(3.0) / 2)},
+        {Point(1, 0), Point(1, std::sqrt(3.0))},
+    };
+    ConvexPolygon polygon(points.begin(), points.end());
+    auto axes = polygon.find_axes_of_symmetry();
+    EXPECT_EQ(axes.size(), 3);
+
+    checkAxes(expectedAxes, axes);
+}
+
+/**
+ * @brief Tests the lazy symmetry queries against the full search.
+ */
+TEST(ConvexPolygonTest, LazySymmetryQueries)
+{
+    std::vector<std::vector<Point>> polygons = {
+        {Point(0, 0), Point(1, 0), Point(1, 1), Point(0, 1)},
+        {Point(0, 0), Point(2, 1), Point(0, 3), Point(-2, 1)},
+        {Point(0.1, 1.0), Point(-1.0, 0.0), Point(0.0, -1.0),
+         Point(1.0, -0.5), Point(2.0, 1.0)},
+    };
+
+    for (const auto &points : polygons)
+    {
+        ConvexPolygon polygon(points.begin(), points.end());
+        auto axes = polygon.find_axes_of_symmetry();
+
+        EXPECT_EQ(polygon.count_axes(), axes.size());
+        EXPECT_EQ(polygon.has_symmetry(), !axes.empty());
+
+        size_t i = 0;
+        for (const auto &axis : polygon.axes())
+        {
+            ASSERT_LT(i, axes.size());
+            EXPECT_TRUE(axis.start_point == axes[i].start_point);
+            EXPECT_TRUE(axis.direction == axes[i].direction);
+            ++i;
+        }
+        EXPECT_EQ(i, axes.size());
+    }
+}
+
+/**
+ * @brief Tests that pruning candidates by the vertex centroid keeps 
+ *        every axis of regular polygons placed away from the origin.
+ */
+TEST(ConvexPolygonTest, CentroidPruningKeepsAxes)
+{
+    const double pi = std::acos(-1.0);
+
+    for (std::size_t n = 3; n <= 12; ++n)
+    {
+        std::vector<Point> points;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            double angle = 0.3 + 2 * pi * i / n;
+            points.emplace_back(
+                100 + 5 * std::cos(angle), -40 + 5 * std::sin(angle));
+        }
+
+        ConvexPolygon polygon(points.begin(), points.end());
+        EXPECT_EQ(polygon.count_axes(1e-6), n);
+
+        // Moving one vertex shifts the centroid off every axis 
+        // that does not go through that vertex
+        points[0] = Point(points[0].x * 1.001, points[0].y);
+        ConvexPolygon distorted(points.begin(), points.end());
+        EXPECT_LE(distorted.count_axes(1e-6), 1);
+    }
+}
+
+/**
+ * @brief Tests the derived properties and that they are recomputed 
+ *        for a transformed copy.
+ */
+TEST(ConvexPolygonTest, DerivedProperties)
+{
+    std::vector<Point> points = {
+        Point(0, 0), Point(3, 0), Point(3, 4)};
+    ConvexPolygon polygon(points.begin(), points.end());
+
+    EXPECT_DOUBLE_EQ(polygon.area(), 6);
+    EXPECT_DOUBLE_EQ(polygon.perimeter(), 12);
+    EXPECT_DOUBLE_EQ(polygon.centroid().x, 2);
+    EXPECT_DOUBLE_EQ(polygon.centroid().y, 4.0 / 3);
+    ASSERT_EQ(polygon.edges().size(), 3);
+    EXPECT_DOUBLE_EQ(polygon.edges()[2].x, -3);
+    ASSERT_EQ(polygon.signature().size(), 3);
+    EXPECT_DOUBLE_EQ(polygon.signature()[2].length, 5);
+
+    ConvexPolygon moved = polygon.transformed(TransformChain().translate(1, 1));
+    EXPECT_DOUBLE_EQ(moved.area(), 6);
+    EXPECT_DOUBLE_EQ(moved.centroid().x, 3);
+
+    ConvexPolygon copy(polygon);
+    EXPECT_DOUBLE_EQ(copy.centroid().y, 4.0 / 3);
+}
+
+namespace
+{
+    void expectMapsOnto(const TransformMatrix &m,
+                        const std::vector<Point> &from,
+                        const std::vector<Point> &to)
+    {
+        for (const auto &p : from)
+        {
+            Point mapped = m * p;
+            bool found = false;
+            for (const auto &q : to)
+            {
+                if (std::abs(mapped.x - q.x) < 1e-9 
+                    && std::abs(mapped.y - q.y) < 1e-9)
+                    found = true;
+            }
+            EXPECT_TRUE(found);
+        }
+    }
+}
+
+/**
+ * @brief Tests that a square matches a moved copy of itself with every 
+ *        rotation and reflection of the square.
+ */
+TEST(ConvexPolygonTest, MatchCongruentSquare)
+{
+    std::vector<Point> a = {
+        Point(0, 0), Point(1, 0), Point(1, 1), Point(0, 1)};
+    std::vector<Point> b;
+    TransformChain chain = TransformChain().rotate(0.7).translate(3, -2);
+    for (const auto &p : a)
+        b.push_back(chain * p);
+    std::rotate(b.begin(), b.begin() + 1, b.end());
+
+    ConvexPolygon pa(a.begin(), a.end());
+    ConvexPolygon pb(b.begin(), b.end());
+
+    auto transforms = pa.match(pb);
+    ASSERT_EQ(transforms.size(), 8);
+    for (const auto &m : transforms)
+        expectMapsOnto(m, a, b);
+}
+
+/**
+ * @brief Tests that a scalene triangle matches its mirror image with 
+ *        exactly one reflection.
+ */
+TEST(ConvexPolygonTest, MatchReflectedTriangle)
+{
+    std::vector<Point> a = {Point(0, 0), Point(4, 0), Point(1, 2)};
+    std::vector<Point> b = {Point(0, 0), Point(-1, 2), Point(-4, 0)};
+
+    ConvexPolygon pa(a.begin(), a.end());
+    ConvexPolygon pb(b.begin(), b.end());
+
+    auto transforms = pa.match(pb);
+    ASSERT_EQ(transforms.size(), 1);
+    expectMapsOnto(transforms[0], a, b);
+
+    double determinant = transforms[0].at(0, 0) * transforms[0].at(1, 1)
+        - transforms[0].at(0, 1) * transforms[0].at(1, 0);
+    EXPECT_NEAR(determinant, -1, 1e-9);
+}
+
+/**
+ * @brief Tests matching a polygon whose edge lengths are spaced less 
+ *        than EPS apart, so that entries match their neighbours within 
+ *        EPS but not each other. Every moved copy, starting from any 
+ *        vertex, must match with its actual correspondence.
+ */
+TEST(ConvexPolygonTest, MatchEntriesCloserThanEPS)
+{
+    // Arcs on the unit circle, in units of d above the mean arc
+    const double pi = std::acos(-1.0);
+    const double d = 0.01;
+    const double units[] = {1.2, 0, 1.2, 0.6, 1.2};
+    const double base = (2 * pi - 4.2 * d) / 5;
+
+    std::vector<Point> a;
+    double angle = 0;
+    for (double u : units)
+    {
+        a.emplace_back(std::cos(angle), std::sin(angle));
+        angle += base + u * d;
+    }
+    const std::size_t n = a.size();
+    ConvexPolygon pa(a.begin(), a.end());
+
+    // The edge lengths differ by about 0.6 and 1.2 times EPS
+    const double EPS = 0.0081;
+    TransformChain chain = TransformChain().rotate(0.4).translate(-1, 2);
+
+    for (std::size_t r = 0; r < n; ++r)
+    {
+        std::vector<Point> b;
+        for (std::size_t k = 0; k < n; ++k)
+            b.push_back(chain.fold() * a[(k + r) % n]);
+        ConvexPolygon pb(b.begin(), b.end());
+
+        auto transforms = pa.match(pb, EPS);
+        bool exact = std::any_of(transforms.begin(), transforms.end(),
+            [&](const TransformMatrix &m)
+            {
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    Point mapped = m * a[i];
+                    const Point &q = b[(i + n - r) % n];
+                    if (std::abs(mapped.x - q.x) > 1e-9 
+                        || std::abs(mapped.y - q.y) > 1e-9)
+                        return false;
+                }
+                return true;
+            });
+        EXPECT_TRUE(exact) << "starting from vertex " << r;
+    }
+}
+
+/**
+ * @brief Tests that polygons which are not congruent do not match.
+ */
+TEST(ConvexPolygonTest, MatchNotCongruent)
+{
+    std::vector<Point> square = {
+        Point(0, 0), Point(1, 0), Point(1, 1), Point(0, 1)};
+    std::vector<Point> rectangle = {
+        Point(0, 0), Point(2, 0), Point(2, 1), Point(0, 1)};
+    std::vector<Point> triangle = {Point(0, 0), Point(1, 0), Point(0, 1)};
+
+    ConvexPolygon ps(square.begin(), square.end());
+    ConvexPolygon pr(rectangle.begin(), rectangle.end());
+    ConvexPolygon pt(triangle.begin(), triangle.end());
+
+    EXPECT_TRUE(ps.match(pr).empty());
+    EXPECT_TRUE(ps.match(pt).empty());
+    EXPECT_EQ(pr.match(pr).size(), 4);
+}
+
+/**
+ * @brief Tests that verify_axes accepts the axes found by the search 
+ *        and rejects other lines, in blocks of any size.
+ */
+TEST(ConvexPolygonTest, VerifyAxes)
+{
+    const double pi = std::acos(-1.0);
+    std::vector<Point> points;
+    for (int i = 0; i < 6; ++i)
+        points.emplace_back(
+            1 + std::cos(pi * i / 3), 2 + std::sin(pi * i / 3));
+    ConvexPolygon polygon(points.begin(), points.end());
+
+    auto found = polygon.find_axes_of_symmetry();
+    ASSERT_EQ(found.size(), 6);
+
+    std::vector<Ray> axes;
+    std::vector<bool> expected;
+    for (int i = 0; i < 20; ++i)
+    {
+        const auto &axis = found[i % found.size()];
+        if (i % 3 == 2)
+        {
+            // Rotated slightly about the centre: not an axis
+            axes.emplace_back(Point(1, 2),
+                Vector(axis.direction.x - 0.01 * axis.direction.y,
+                       axis.direction.y + 0.01 * axis.direction.x));
+            expected.push_back(false);
+        }
+        else
+        {
+            axes.emplace_back(
+                axis.start_point, 
+                Vector(axis.direction.x * 3, axis.direction.y * 3));
+            expected.push_back(true);
+        }
+    }
+    axes.emplace_back(Point(1, 2), Vector(0, 0));
+    expected.push_back(false);
+
+    EXPECT_EQ(polygon.verify_axes(axes, 1e-9), expected);
+    EXPECT_TRUE(polygon.verify_axes(std::vector<Ray>()).empty());
+}
+
+/**
+ * @brief Tests that verify_axes rejects a line that maps a vertex 
+ *        lying off it onto itself, which candidates through vertices 
+ *        never do.
+ */
+TEST(ConvexPolygonTest, VerifyAxesRejectsOffAxisVertex)
+{
+    std::vector<Point> triangle = {
+        Point(-1, 0), Point(1, 0), Point(0.5, 2)};
+    std::vector<Point> quad = {
+        Point(0.3, -1), Point(1, 0), Point(-0.2, 2), Point(-1, 0)};
+    const std::vector<Ray> axis = {Ray(Point(0, 0), Vector(0, 1))};
+
+    ConvexPolygon pt(triangle.begin(), triangle.end());
+    ConvexPolygon pq(quad.begin(), quad.end());
+
+    EXPECT_EQ(pt.count_axes(), 0);
+    EXPECT_EQ(pq.count_axes(), 0);
+    EXPECT_EQ(pt.verify_axes(axis), std::vector<bool>{false});
+    EXPECT_EQ(pq.verify_axes(axis), std::vector<bool>{false});
+
+    // Moved onto the axis, the same vertices make it an axis
+    triangle[2] = Point(0, 2);
+    quad[0] = Point(0, -1);
+    quad[2] = Point(0, 2);
+    ConvexPolygon st(triangle.begin(), triangle.end());
+    ConvexPolygon sq(quad.begin(), quad.end());
+    EXPECT_EQ(st.verify_axes(axis), std::vector<bool>{true});
+    EXPECT_EQ(sq.verify_axes(axis), std::vector<bool>{true});
+}
+
+/**
+ * @brief Tests that verify_axes and the axis search agree on every 
+ *        tolerance, including the ones at which an axis appears.
+ */
+TEST(ConvexPolygonTest, VerifyAxesAgreesWithSearch)
+{
+    // A regular hexagon with one vertex moved outwards keeps one axis 
+    // exactly; the others only hold above growing tolerances
+    const double pi = std::acos(-1.0);
+    std::vector<Point> points;
+    for (int i = 0; i < 6; ++i)
+    {
+        const double radius = i == 0 ? 1.001 : 1;
+        points.emplace_back(1 + radius * std::cos(pi * i / 3),
+                            2 + radius * std::sin(pi * i / 3));
+    }
+    ConvexPolygon polygon(points.begin(), points.end());
+
+    const auto all = ConvexPolygon(polygon).find_axes_of_symmetry(1e-2);
+    ASSERT_EQ(all.size(), 6);
+
+    std::set<std::size_t> counts;
+    for (double eps = 1e-6; eps < 1e-2; eps *= 1.02)
+    {
+        // A fresh copy each time, so that no cached axes are reused
+        const auto found = ConvexPolygon(polygon).find_axes_of_symmetry(eps);
+        counts.insert(found.size());
+
+        const auto holds = polygon.verify_axes(all, eps);
+        for (std::size_t i = 0; i < all.size(); ++i)
+        {
+            const bool is_found = std::any_of(found.begin(), found.end(),
+                [&](const Ray &axis)
+                {
+                    return axis.start_point == all[i].start_point
+                        && axis.direction == all[i].direction;
+                });
+            EXPECT_EQ(holds[i], is_found) << "axis " << i << ", EPS " << eps;
+        }
+    }
+
+    // The sweep crosses the tolerances at which the axes appear
+    EXPECT_GT(counts.size(), 2);
+}
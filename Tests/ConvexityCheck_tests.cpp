@@ -0,0 +1,106 @@
+#define _USE_MATH_DEFINES
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <execution>
+#include <vector>
+
+#include "ConvexityCheck.h"
+#include "ConvexPolygon.h"
+
+namespace
+{
+    std::vector<Point> make_circle(size_t n)
+    {
+        std::vector<Point> points;
+        for (size_t i = 0; i < n; ++i)
+        {
+            double angle = 2 * M_PI * i / n;
+            points.emplace_back(std::cos(angle), std::sin(angle));
+        }
+        return points;
+    }
+}
+
+/**
+ * @brief Tests the turns found in parts of a square.
+ */
+TEST(ConvexityCheckTest, Turns)
+{
+    std::vector<Point> points = {
+        Point(0, 0), 
+        Point(1, 0), 
+        Point(1, 1), 
+        Point(0, 1)
+    };
+    ConvexityCheck check(points.data(), points.size());
+
+    auto turns = check.turns(0, 4);
+    EXPECT_TRUE(turns.positive);
+    EXPECT_FALSE(turns.non_positive);
+    EXPECT_FALSE(turns.mixed());
+    EXPECT_TRUE(check.is_convex());
+}
+
+/**
+ * @brief Tests the parallel check of a large convex polygon.
+ */
+TEST(ConvexityCheckTest, ParallelConvex)
+{
+    auto points = make_circle(4 * ConvexityCheck::PARALLEL_THRESHOLD);
+    ConvexityCheck check(points.data(), points.size());
+
+    EXPECT_TRUE(check.is_convex_parallel(4));
+}
+
+/**
+ * @brief Tests that the parallel check finds violations inside a chunk 
+ *        and at the boundary of two chunks.
+ */
+TEST(ConvexityCheckTest, ParallelViolation)
+{
+    const size_t n = 4 * ConvexityCheck::PARALLEL_THRESHOLD;
+
+    for (size_t dent : {n / 3, n / 4 - 1, n / 4, n - 1})
+    {
+        auto points = make_circle(n);
+        points[dent] = Point(0, 0);
+        ConvexityCheck check(points.data(), points.size());
+
+        EXPECT_FALSE(check.is_convex_parallel(4));
+        EXPECT_FALSE(check.is_convex());
+    }
+}
+
+/**
+ * @brief Tests that the two directions found in different chunks are 
+ *        combined into a violation.
+ */
+TEST(ConvexityCheckTest, ParallelDirectionsCombined)
+{
+    auto points = make_circle(4 * ConvexityCheck::PARALLEL_THRESHOLD);
+
+    // A figure eight: the second half turns clockwise
+    for (size_t i = points.size() / 2; i < points.size(); ++i)
+        points[i] = Point(points[i].x + 2, -points[i].y);
+
+    ConvexityCheck check(points.data(), points.size());
+    EXPECT_FALSE(check.is_convex_parallel(2));
+}
+
+/**
+ * @brief Tests constructing polygons with execution policies.
+ */
+TEST(ConvexityCheckTest, ExecutionPolicy)
+{
+    auto points = make_circle(2 * ConvexityCheck::PARALLEL_THRESHOLD);
+
+    ConvexPolygon parallel(std::execution::par, points.begin(), points.end());
+    ConvexPolygon sequenced(std::execution::seq, points.begin(), points.end());
+
+    points[100] = Point(0, 0);
+    EXPECT_THROW(
+        ConvexPolygon(std::execution::par, points.begin(), points.end()),
+        std::invalid_argument);
+}
@@ -0,0 +1,191 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <memory_resource>
+#include <thread>
+#include <vector>
+
+#include "ConvexPolygon.h"
+#include "PolygonCache.h"
+
+namespace
+{
+    /**
+     * @brief Memory resource counting the allocations passed upstream.
+     */
+    class CountingResource : public std::pmr::memory_resource
+    {
+    public:
+        std::size_t allocations = 0;
+
+    private:
+        void *do_allocate(std::size_t bytes, std::size_t alignment) override
+        {
+            ++allocations;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void *p, std::size_t bytes,
+                           std::size_t alignment) override
+        {
+            std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+        }
+
+        bool do_is_equal(
+            const std::pmr::memory_resource &other) const noexcept override
+        {
+            return this == &other;
+        }
+    };
+}
+
+/**
+ * @brief Tests the geometry computed for a rectangle.
+ */
+TEST(PolygonCacheTest, ComputesGeometry)
+{
+    std::vector<Point> points = {
+        Point(0, 0), Point(4, 0), Point(4, 2), Point(0, 2)};
+
+    PolygonCache cache;
+    const auto &geometry = cache.geometry(
+        points.data(), points.size(), std::pmr::get_default_resource());
+
+    ASSERT_EQ(geometry.edges.size(), 4);
+    EXPECT_DOUBLE_EQ(geometry.edges[1].x, 0);
+    EXPECT_DOUBLE_EQ(geometry.edges[1].y, 2);
+    EXPECT_DOUBLE_EQ(geometry.edges[3].y, -2);
+    EXPECT_DOUBLE_EQ(geometry.signature[0].length, 4);
+    EXPECT_DOUBLE_EQ(geometry.signature[0].angle, std::acos(-1.0) / 2);
+    EXPECT_DOUBLE_EQ(geometry.perimeter, 12);
+    EXPECT_DOUBLE_EQ(geometry.area, 8);
+
+    // Later calls return the same data
+    EXPECT_EQ(&cache.geometry(points.data(), points.size(),
+                              std::pmr::get_default_resource()),
+              &geometry);
+}
+
+/**
+ * @brief Tests that the axes are stored per tolerance and that the 
+ *        first axes stored for a tolerance are kept.
+ */
+TEST(PolygonCacheTest, StoresAxesPerTolerance)
+{
+    auto *resource = std::pmr::get_default_resource();
+    PolygonCache cache;
+    EXPECT_EQ(cache.find_axes(1e-9), nullptr);
+
+    std::vector<Ray> one = {Ray(Point(0, 0), Vector(1, 0))};
+    const auto *stored = cache.store_axes(
+        1e-9, one.data(), one.size(), resource);
+
+    std::vector<Ray> two = {
+        Ray(Point(0, 0), Vector(0, 1)), Ray(Point(0, 0), Vector(1, 1))};
+    const auto *again = cache.store_axes(
+        1e-9, two.data(), two.size(), resource);
+
+    ASSERT_NE(stored, nullptr);
+    EXPECT_EQ(again, stored);
+    EXPECT_EQ(cache.find_axes(1e-9), stored);
+    EXPECT_EQ(stored->size(), 1);
+    EXPECT_EQ(cache.find_axes(1e-6), nullptr);
+}
+
+/**
+ * @brief Tests that only MAX_AXES_ENTRIES tolerances are cached, while 
+ *        the polygon still finds the axes for any other tolerance.
+ */
+TEST(PolygonCacheTest, LimitsCachedTolerances)
+{
+    auto *resource = std::pmr::get_default_resource();
+    PolygonCache cache;
+
+    std::vector<Ray> axes = {Ray(Point(0, 0), Vector(1, 0))};
+    for (std::size_t i = 0; i < 2 * PolygonCache::MAX_AXES_ENTRIES; ++i)
+    {
+        double EPS = 1e-9 * (i + 1);
+        const auto *stored =
+            cache.store_axes(EPS, axes.data(), axes.size(), resource);
+        EXPECT_EQ(stored != nullptr, i < PolygonCache::MAX_AXES_ENTRIES);
+        EXPECT_EQ(cache.find_axes(EPS), stored);
+    }
+
+    std::vector<Point> points = {
+        Point(0, 0), Point(2, 0), Point(2, 1), Point(0, 1)};
+    const ConvexPolygon polygon(points.begin(), points.end());
+    for (std::size_t i = 0; i < 2 * PolygonCache::MAX_AXES_ENTRIES; ++i)
+    {
+        EXPECT_EQ(polygon.find_axes_of_symmetry(1e-9 * (i + 1)).size(), 2);
+        EXPECT_EQ(polygon.count_axes(1e-9 * (i + 1)), 2);
+    }
+}
+
+/**
+ * @brief Tests that the lazy symmetry queries allocate nothing.
+ */
+TEST(PolygonCacheTest, LazyQueriesDoNotAllocate)
+{
+    std::vector<Point> points = {
+        Point(0, 0), Point(2, 0), Point(2, 1), Point(0, 1)};
+
+    CountingResource resource;
+    const ConvexPolygon polygon(points.begin(), points.end(), &resource);
+    const std::size_t allocations = resource.allocations;
+
+    EXPECT_TRUE(polygon.has_symmetry());
+    EXPECT_EQ(polygon.count_axes(), 2);
+    EXPECT_DOUBLE_EQ(polygon.centroid().x, 1);
+    EXPECT_EQ(resource.allocations, allocations);
+}
+
+/**
+ * @brief Tests that a copied cache starts empty.
+ */
+TEST(PolygonCacheTest, CopyStartsEmpty)
+{
+    auto *resource = std::pmr::get_default_resource();
+    PolygonCache cache;
+    cache.store_axes(1e-9, nullptr, 0, resource);
+
+    PolygonCache copy(cache);
+    EXPECT_EQ(copy.find_axes(1e-9), nullptr);
+    EXPECT_NE(cache.find_axes(1e-9), nullptr);
+
+    cache = copy;
+    EXPECT_EQ(cache.find_axes(1e-9), nullptr);
+}
+
+/**
+ * @brief Tests that threads sharing a polygon get the same cached data.
+ */
+TEST(PolygonCacheTest, SharedAcrossThreads)
+{
+    std::vector<Point> points;
+    for (int i = 0; i < 64; ++i)
+    {
+        double angle = 2 * std::acos(-1.0) * i / 64;
+        points.emplace_back(std::cos(angle), std::sin(angle));
+    }
+    const ConvexPolygon polygon(points.begin(), points.end());
+
+    std::vector<const void *> edges(8);
+    std::vector<std::size_t> counts(8);
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < edges.size(); ++t)
+    {
+        threads.emplace_back([&, t]
+        {
+            edges[t] = polygon.edges().data();
+            counts[t] = polygon.find_axes_of_symmetry(1e-6).size();
+        });
+    }
+    for (auto &thread : threads)
+        thread.join();
+
+    for (std::size_t t = 0; t < edges.size(); ++t)
+    {
+        EXPECT_EQ(edges[t], edges[0]);
+        EXPECT_EQ(counts[t], 64);
+    }
+}
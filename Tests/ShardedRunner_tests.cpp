@@ -0,0 +1,226 @@
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "ShardedRunner.h"
+
+namespace fs = std::filesystem;
+
+std::string test_executable;
+
+namespace
+{
+    /**
+     * @brief Thrown by a job to imitate a crashing worker.
+     */
+    struct Crash {};
+
+    ShardedRunner::Options make_options(const fs::path &directory)
+    {
+        fs::remove_all(directory);
+        fs::create_directories(directory);
+
+        ShardedRunner::Options options;
+        options.manifest = directory / "manifest.txt";
+        options.output_dir = directory / "out";
+        options.shards = 2;
+        options.jobs = 1;
+        options.checkpoint_interval = 2;
+
+        std::ofstream manifest(options.manifest);
+        for (int i = 0; i < 7; ++i)
+            manifest << "polygon" << i << ".txt\n";
+
+        return options;
+    }
+
+    void write_name(const std::string &filename, AxisWriter &writer)
+    {
+        writer.write_axes(filename, std::vector<Ray>());
+    }
+
+    std::string expected_output()
+    {
+        std::string expected;
+        for (int i = 0; i < 7; ++i)
+        {
+            expected += "polygon" + std::to_string(i) + ".txt:\n"
+                        "The polygon is non-symmetric.\n";
+        }
+        return expected;
+    }
+}
+
+/**
+ * @brief Runs a shard like the worker processes of the application. 
+ *        With "--crash-once <marker>", the worker dies in the middle of 
+ *        its shard unless the marker file exists, which it creates.
+ * @param argc Number of command line arguments.
+ * @param argv Options and values of the worker command line.
+ * @return Exit status.
+ */
+int run_shard_worker(int argc, char **argv)
+{
+    ShardedRunner::Options options;
+    std::size_t shard = 0;
+    fs::path crash_marker;
+
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        std::string arg = argv[i];
+        std::string value = argv[i + 1];
+
+        if (arg == "--manifest")
+            options.manifest = value;
+        else if (arg == "--out")
+            options.output_dir = value;
+        else if (arg == "--shards")
+            options.shards = std::stoul(value);
+        else if (arg == "--checkpoint-interval")
+            options.checkpoint_interval = std::stoul(value);
+        else if (arg == "--shard-worker")
+            shard = std::stoul(value);
+        else if (arg == "--crash-once")
+            crash_marker = value;
+    }
+
+    int processed = 0;
+    return ShardedRunner(options).run_shard(
+        shard,
+        [&](const std::string &filename, AxisWriter &writer)
+        {
+            if (!crash_marker.empty() && ++processed == 3
+                && !fs::exists(crash_marker))
+            {
+                std::ofstream(crash_marker) << shard;
+                std::_Exit(3);
+            }
+            write_name(filename, writer);
+        });
+}
+
+/**
+ * @brief Tests that the shards cover the manifest once and in order.
+ */
+TEST(ShardedRunnerTest, ShardsAndMerge)
+{
+    auto options = make_options(fs::temp_directory_path() / "sharded_runner_merge");
+    ShardedRunner runner(options);
+
+    fs::create_directories(options.output_dir);
+    EXPECT_EQ(runner.run_shard(0, write_name), EXIT_SUCCESS);
+    EXPECT_EQ(runner.run_shard(1, write_name), EXIT_SUCCESS);
+
+    // All shards are finished, so no worker process is started
+    std::ostringstream output;
+    EXPECT_EQ(runner.run(output), EXIT_SUCCESS);
+    EXPECT_EQ(output.str(), expected_output());
+}
+
+/**
+ * @brief Tests that a crashed shard resumes from its last checkpoint 
+ *        without duplicate or lost records.
+ */
+TEST(ShardedRunnerTest, ResumeAfterCrash)
+{
+    auto options = make_options(fs::temp_directory_path() / "sharded_runner_resume");
+    ShardedRunner runner(options);
+    fs::create_directories(options.output_dir);
+
+    int processed = 0;
+    auto crashing =
+        [&processed](const std::string &filename, AxisWriter &writer)
+    {
+        if (++processed == 3)
+            throw Crash();
+        write_name(filename, writer);
+    };
+
+    EXPECT_THROW(runner.run_shard(0, crashing), Crash);
+    EXPECT_EQ(runner.run_shard(0, write_name), EXIT_SUCCESS);
+    EXPECT_EQ(runner.run_shard(1, write_name), EXIT_SUCCESS);
+
+    std::ostringstream output;
+    EXPECT_EQ(runner.run(output), EXIT_SUCCESS);
+    EXPECT_EQ(output.str(), expected_output());
+}
+
+/**
+ * @brief Tests that failed polygons are recorded and reported.
+ */
+TEST(ShardedRunnerTest, FailedPolygons)
+{
+    auto options = make_options(fs::temp_directory_path() / "sharded_runner_failed");
+    ShardedRunner runner(options);
+    fs::create_directories(options.output_dir);
+
+    auto failing =
+        [](const std::string &filename, AxisWriter &writer)
+    {
+        if (filename == "polygon5.txt")
+            throw std::runtime_error("Unable to open file.");
+        write_name(filename, writer);
+    };
+
+    EXPECT_EQ(runner.run_shard(0, failing), EXIT_SUCCESS);
+    EXPECT_EQ(runner.run_shard(1, failing), EXIT_SUCCESS);
+
+    std::ostringstream output;
+    EXPECT_EQ(runner.run(output), EXIT_FAILURE);
+    EXPECT_NE(
+        output.str().find("polygon5.txt:\nError: Unable to open file.\n"),
+        std::string::npos);
+}
+
+/**
+ * @brief Tests worker processes end to end: a crashed worker fails the run 
+ *        without retries, and the next run restarts it from its checkpoint.
+ */
+TEST(ShardedRunnerTest, WorkerProcessesResume)
+{
+    fs::path directory = fs::temp_directory_path() / "sharded_runner_workers";
+    auto options = make_options(directory);
+    options.executable = fs::absolute(test_executable).string();
+    options.worker_arguments = {
+        "--crash-once", (directory / "crashed").string()};
+    options.retries = 0;
+
+    std::ostringstream output;
+    EXPECT_THROW(ShardedRunner(options).run(output), std::runtime_error);
+    EXPECT_TRUE(fs::exists(directory / "crashed"));
+
+    options.retries = 1;
+    EXPECT_EQ(ShardedRunner(options).run(output), EXIT_SUCCESS);
+    EXPECT_EQ(output.str(), expected_output());
+}
+
+/**
+ * @brief Tests that a run is not resumed with other worker arguments.
+ */
+TEST(ShardedRunnerTest, ResumeNeedsSameArguments)
+{
+    auto options = make_options(
+        fs::temp_directory_path() / "sharded_runner_arguments");
+    ShardedRunner runner(options);
+    fs::create_directories(options.output_dir);
+
+    EXPECT_EQ(runner.run_shard(0, write_name), EXIT_SUCCESS);
+    EXPECT_EQ(runner.run_shard(1, write_name), EXIT_SUCCESS);
+
+    std::ostringstream output;
+    EXPECT_EQ(runner.run(output), EXIT_SUCCESS);
+
+    auto changed = options;
+    changed.worker_arguments = {"--format", "jsonl"};
+    EXPECT_THROW(ShardedRunner(changed).run(output), std::runtime_error);
+
+    changed = options;
+    changed.format = OutputFormat::JsonLines;
+    EXPECT_THROW(ShardedRunner(changed).run(output), std::runtime_error);
+}
@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+
+#include "StreamPipeline.h"
+#include "TextAxisWriter.h"
+
+/**
+ * @brief Tests that several polygons are processed in the input order.
+ */
+TEST(StreamPipelineTest, KeepsInputOrder)
+{
+    std::ostringstream expected;
+    std::ostringstream text;
+
+    for (int i = 0; i < 200; ++i)
+    {
+        if (i % 2 == 0)
+        {
+            // Square
+            text << "0 0\n1 0\n1 1\n0 1\n\n";
+            expected << "Polygon " << i << ":\n"
+                     << "Axes of symmetry:\n"
+                     << "0 0 - 1 1\n"
+                     << "0.5 0 - 0.5 1\n"
+                     << "1 0 - 0 1\n"
+                     << "1 0.5 - 0 0.5\n";
+        }
+        else
+        {
+            text << "0.1 1.0\n-1.0 0.0\n0.0 -1.0\n1.0 -0.5\n2.0 1.0\n\n\n";
+            expected << "Polygon " << i << ":\n"
+                     << "The polygon is non-symmetric.\n";
+        }
+    }
+
+    std::istringstream input(text.str());
+    std::ostringstream output;
+
+    StreamPipeline::Options options;
+    options.parse_workers = 2;
+    options.validate_workers = 2;
+    options.symmetry_workers = 3;
+    options.queue_capacity = 4;
+
+    TextAxisWriter writer(output);
+    StreamPipeline pipeline(input, writer, options);
+    EXPECT_EQ(pipeline.run(), 0);
+    EXPECT_EQ(output.str(), expected.str());
+}
+
+/**
+ * @brief Tests that invalid polygons are reported without stopping 
+ *        the stream.
+ */
+TEST(StreamPipelineTest, ReportsInvalidPolygons)
+{
+    std::istringstream input(
+        "0 0\n1 1\n1 0\n0 1\n"
+        "\n"
+        "0 0\nabc\n"
+        "\n"
+        "0 0\n2 1\n0 3\n-2 1\n");
+    std::ostringstream output;
+
+    TextAxisWriter writer(output);
+    StreamPipeline pipeline(input, writer);
+    EXPECT_EQ(pipeline.run(), 2);
+    EXPECT_EQ(
+        output.str(),
+        "Polygon 0:\n"
+        "Error: Points do not form a convex polygon.\n"
+        "Polygon 1:\n"
+        "Error: Invalid point format in stream.\n"
+        "Polygon 2:\n"
+        "Axes of symmetry:\n"
+        "0 0 - 0 3\n");
+}
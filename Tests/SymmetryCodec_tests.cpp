@@ -0,0 +1,211 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <vector>
+
+#include "ConvexPolygon.h"
+#include "SymmetryCodec.h"
+
+namespace
+{
+    void expectSamePolygon(const ConvexPolygon &actual,
+                           const std::vector<Point> &expected)
+    {
+        ASSERT_EQ((std::size_t)(actual.end() - actual.begin()),
+                  expected.size());
+
+        auto p = actual.begin();
+        for (const auto &q : expected)
+        {
+            EXPECT_NEAR(p->x, q.x, 1e-9);
+            EXPECT_NEAR(p->y, q.y, 1e-9);
+            ++p;
+        }
+    }
+
+    std::vector<Point> regularPolygon(std::size_t n, double phase)
+    {
+        std::vector<Point> points;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            double angle = phase + 2 * std::acos(-1.0) * i / n;
+            points.emplace_back(3 + 2 * std::cos(angle), -1 + 2 * std::sin(angle));
+        }
+        return points;
+    }
+
+    /**
+     * @brief Places vertices on a circle at the given angles and at their
+     *        negatives, which makes the x axis an axis of symmetry.
+     *        Angles 0 and pi are placed once. The first vertex is the one
+     *        at the first angle.
+     */
+    std::vector<Point> mirroredPolygon(const std::vector<double> &angles)
+    {
+        const double pi = std::acos(-1.0);
+        std::vector<double> all;
+        for (double angle : angles)
+        {
+            if (angle > 0 && angle < pi)
+                all.push_back(-angle);
+            all.push_back(angle);
+        }
+        std::sort(all.begin(), all.end());
+        std::rotate(all.begin(),
+                    std::find(all.begin(), all.end(), angles.front()),
+                    all.end());
+
+        std::vector<Point> points;
+        for (double angle : all)
+            points.emplace_back(std::cos(angle), std::sin(angle));
+        return points;
+    }
+
+    std::size_t writtenSize(const SymmetryCodec::Encoded &encoded)
+    {
+        std::ostringstream stream;
+        SymmetryCodec::write(encoded, stream);
+        return stream.str().size();
+    }
+}
+
+/**
+ * @brief Tests that regular polygons keep 1/(2n) of their vertices 
+ *        and decode to the original vertices.
+ */
+TEST(SymmetryCodecTest, RegularPolygons)
+{
+    SymmetryCodec codec(1e-9);
+
+    for (std::size_t n = 4; n <= 12; ++n)
+    {
+        auto points = regularPolygon(n, 0.4);
+        ConvexPolygon polygon(points.begin(), points.end());
+
+        auto encoded = codec.encode(polygon);
+        EXPECT_EQ(encoded.order, n);
+        EXPECT_LE(encoded.points.size(), 1);
+
+        expectSamePolygon(codec.decode(encoded), points);
+    }
+}
+
+/**
+ * @brief Tests polygons with a single axis, through vertices and 
+ *        through edge midpoints.
+ */
+TEST(SymmetryCodecTest, SingleAxis)
+{
+    SymmetryCodec codec;
+    std::vector<std::vector<Point>> polygons = {
+        // Axis through two vertices, starting mid-chain
+        mirroredPolygon({0.5, 0, 1.2, 2.0, 2.5, std::acos(-1.0)}),
+        // Axis through two edge midpoints
+        mirroredPolygon({0.3, 1.0, 1.9, 2.8}),
+        // Axis through a vertex and an edge midpoint
+        mirroredPolygon({0, 0.6, 1.5, 2.6}),
+    };
+
+    for (const auto &points : polygons)
+    {
+        ConvexPolygon polygon(points.begin(), points.end());
+
+        auto encoded = codec.encode(polygon);
+        EXPECT_EQ(encoded.order, 1);
+        EXPECT_LT(encoded.points.size(), points.size());
+
+        expectSamePolygon(codec.decode(encoded), points);
+    }
+}
+
+/**
+ * @brief Tests that polygons without symmetry are stored whole.
+ */
+TEST(SymmetryCodecTest, AsymmetricStoredWhole)
+{
+    std::vector<Point> points = {
+        Point(0.1, 1.0), Point(-1.0, 0.0), Point(0.0, -1.0),
+        Point(1.0, -0.5), Point(2.0, 1.0)};
+    ConvexPolygon polygon(points.begin(), points.end());
+
+    SymmetryCodec codec;
+    auto encoded = codec.encode(polygon);
+    EXPECT_EQ(encoded.order, 0);
+    EXPECT_EQ(encoded.points.size(), points.size());
+
+    expectSamePolygon(codec.decode(encoded), points);
+}
+
+/**
+ * @brief Tests the binary round trip and that truncated data is rejected.
+ */
+TEST(SymmetryCodecTest, BinaryRoundTrip)
+{
+    SymmetryCodec codec;
+    std::vector<Point> points = {
+        Point(0, 0), Point(4, 0), Point(4, 2), Point(0, 2)};
+    ConvexPolygon polygon(points.begin(), points.end());
+
+    std::stringstream stream;
+    SymmetryCodec::write(codec.encode(polygon), stream);
+    auto data = stream.str();
+
+    expectSamePolygon(codec.decode(SymmetryCodec::read(stream)), points);
+
+    std::istringstream truncated(data.substr(0, data.size() - 1));
+    EXPECT_THROW(SymmetryCodec::read(truncated), std::runtime_error);
+}
+
+/**
+ * @brief Tests that inconsistent symmetry data is rejected.
+ */
+TEST(SymmetryCodecTest, RejectsInconsistentData)
+{
+    SymmetryCodec codec;
+    SymmetryCodec::Encoded encoded;
+    encoded.vertex_count = 5;
+    encoded.order = 2;
+    encoded.axis = Ray(Point(0, 0), Vector(1, 0));
+
+    EXPECT_THROW(codec.decode(encoded), std::invalid_argument);
+}
+
+/**
+ * @brief Tests that the encoding is never larger than storing the 
+ *        polygon whole, so small symmetric polygons are stored whole.
+ */
+TEST(SymmetryCodecTest, NeverGrows)
+{
+    SymmetryCodec codec;
+    std::vector<std::vector<Point>> polygons = {
+        // Kite
+        {Point(0, 0), Point(2, 1), Point(0, 5), Point(-2, 1)},
+        // Rectangle
+        {Point(0, 0), Point(4, 0), Point(4, 2), Point(0, 2)},
+        // Isosceles triangle
+        {Point(0, 0), Point(4, 0), Point(2, 3)},
+        // House
+        {Point(0, 0), Point(2, 0), Point(2, 2), Point(1, 3), Point(0, 2)},
+        // Trapezoid
+        {Point(3, 2), Point(-3, 2), Point(-5, 0), Point(5, 0)},
+        regularPolygon(3, 0.4),
+        regularPolygon(6, 0.4),
+        mirroredPolygon({0.3, 1.0, 1.9, 2.8}),
+    };
+
+    for (const auto &points : polygons)
+    {
+        ConvexPolygon polygon(points.begin(), points.end());
+
+        SymmetryCodec::Encoded whole;
+        whole.vertex_count = (std::uint32_t)points.size();
+        whole.points = points;
+
+        auto encoded = codec.encode(polygon);
+        EXPECT_LE(writtenSize(encoded), writtenSize(whole));
+
+        expectSamePolygon(codec.decode(encoded), points);
+    }
+}
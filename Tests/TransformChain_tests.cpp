@@ -0,0 +1,102 @@
+#define _USE_MATH_DEFINES
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "ConvexPolygon.h"
+#include "TransformChain.h"
+
+/**
+ * @brief Tests that an empty chain is the identity.
+ */
+TEST(TransformChainTest, Identity)
+{
+    TransformChain chain;
+    Point result = chain * Point(1, 2);
+    EXPECT_DOUBLE_EQ(result.x, 1);
+    EXPECT_DOUBLE_EQ(result.y, 2);
+}
+
+/**
+ * @brief Tests that the steps are applied in the order they were added.
+ */
+TEST(TransformChainTest, Order)
+{
+    TransformChain chain;
+    chain.scale(2, 3).translate(1, 1).rotate(M_PI / 2);
+
+    // (1, 1) -> (2, 3) -> (3, 4) -> (-4, 3)
+    Point result = chain * Point(1, 1);
+    EXPECT_NEAR(result.x, -4, 1e-9);
+    EXPECT_NEAR(result.y, 3, 1e-9);
+}
+
+/**
+ * @brief Tests that the folded matrix equals the product of the steps.
+ */
+TEST(TransformChainTest, FoldMatchesProduct)
+{
+    TransformMatrix translation, rotation, scaling;
+    translation.set_translation(3, -2);
+    rotation.set_rotation(0.3);
+    scaling.set_scaling(1.5, 0.5);
+
+    TransformChain chain;
+    chain.then(translation).then(rotation).then(scaling);
+
+    TransformMatrix folded = chain.fold();
+    TransformMatrix product = scaling * rotation * translation;
+
+    for (int i = 0; i < 3; ++i)
+        for (int j = 0; j < 3; ++j)
+            EXPECT_NEAR(folded.at(i, j), product.at(i, j), 1e-12);
+}
+
+/**
+ * @brief Tests transforming ranges and arrays of points.
+ */
+TEST(TransformChainTest, Apply)
+{
+    TransformChain chain;
+    chain.translate(1, 2).scale(2, 2);
+
+    std::vector<Point> points = {Point(0, 0), Point(1, 0), Point(0, 1)};
+    std::vector<Point> copied;
+    chain.apply(points.begin(), points.end(), std::back_inserter(copied));
+    chain.apply(points.data(), points.size());
+
+    ASSERT_EQ(copied.size(), 3);
+    for (size_t i = 0; i < points.size(); ++i)
+        EXPECT_TRUE(points[i] == copied[i]);
+
+    EXPECT_DOUBLE_EQ(points[1].x, 4);
+    EXPECT_DOUBLE_EQ(points[1].y, 4);
+}
+
+/**
+ * @brief Tests transforming a polygon, which keeps its symmetry.
+ */
+TEST(TransformChainTest, TransformedPolygon)
+{
+    std::vector<Point> points = {
+        Point(0, 0), 
+        Point(2, 1), 
+        Point(0, 3), 
+        Point(-2, 1),
+    };
+    ConvexPolygon polygon(points.begin(), points.end());
+
+    TransformChain chain;
+    chain.rotate(M_PI / 2).translate(10, 0);
+
+    auto axes = polygon.transformed(chain).find_axes_of_symmetry();
+    ASSERT_EQ(axes.size(), 1);
+    EXPECT_TRUE(axes[0].is_point_on_ray(Point(10, 0)));
+    EXPECT_TRUE(axes[0].is_point_on_ray(Point(7, 0)));
+
+    TransformChain singular;
+    singular.scale(0, 1);
+    EXPECT_THROW(polygon.transformed(singular), std::invalid_argument);
+}
@@ -0,0 +1,209 @@
+#define _USE_MATH_DEFINES
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <memory_resource>
+#include <vector>
+
+#include "ConvexPolygon.h"
+#include "VertexSimplifier.h"
+
+namespace
+{
+    /**
+     * @brief Samples a closed outline at evenly spaced angles.
+     */
+    template <typename Shape>
+    std::vector<Point> sampledOutline(int n, Shape shape)
+    {
+        std::vector<Point> points;
+        for (int i = 0; i < n; ++i)
+            points.push_back(shape(2 * M_PI * i / n));
+        return points;
+    }
+}
+
+/**
+ * @brief Tests merging duplicate and collinear vertices of a square, 
+ *        including the ones around the closing edge.
+ */
+TEST(VertexSimplifierTest, CollinearAndDuplicates)
+{
+    std::vector<Point> points = {
+        Point(0.5, 0),
+        Point(1, 0),
+        Point(1, 0),
+        Point(1, 0.25),
+        Point(1, 0.5),
+        Point(1, 1),
+        Point(0, 1),
+        Point(0, 0.5),
+        Point(0, 0),
+        Point(0.25, 0),
+    };
+
+    VertexSimplifier().simplify(points);
+
+    std::vector<Point> expected = {
+        Point(1, 0), Point(1, 1), Point(0, 1), Point(0, 0)
+    };
+    ASSERT_EQ(points.size(), expected.size());
+    for (size_t i = 0; i < points.size(); ++i)
+        EXPECT_TRUE(points[i] == expected[i]);
+}
+
+/**
+ * @brief Tests that a polygon without redundant vertices is kept intact.
+ */
+TEST(VertexSimplifierTest, NothingToRemove)
+{
+    std::vector<Point> points = {
+        Point(0, 0), 
+        Point(2, 1), 
+        Point(0, 3), 
+        Point(-2, 1),
+    };
+    std::vector<Point> original = points;
+
+    VertexSimplifier(1e-9, 0.1).simplify(points);
+
+    ASSERT_EQ(points.size(), original.size());
+    for (size_t i = 0; i < points.size(); ++i)
+        EXPECT_TRUE(points[i] == original[i]);
+}
+
+/**
+ * @brief Tests that nearly collinear vertices are removed only within 
+ *        the tolerance.
+ */
+TEST(VertexSimplifierTest, Tolerance)
+{
+    // An over-sampled ellipse, whose curvature varies along the outline
+    std::vector<Point> ellipse = sampledOutline(1000, [](double angle)
+    {
+        return Point(2 * std::cos(angle), std::sin(angle));
+    });
+    const std::size_t n = ellipse.size();
+
+    std::vector<Point> exact = ellipse;
+    VertexSimplifier().simplify(exact);
+    EXPECT_EQ(exact.size(), n);
+
+    std::vector<Point> coarse = ellipse;
+    VertexSimplifier(1e-9, 1e-3).simplify(coarse);
+    EXPECT_LE(coarse.size(), n / 5);
+    EXPECT_GE(coarse.size(), 3);
+
+    // Every original vertex stays within the tolerance of the outline
+    for (const auto &p : ellipse)
+    {
+        double nearest = INFINITY;
+        for (size_t i = 0; i < coarse.size(); ++i)
+        {
+            const Point &a = coarse[i];
+            const Point &b = coarse[(i + 1) % coarse.size()];
+            Vector ab = b - a;
+            double t = std::clamp(
+                (p - a).dot_product(ab) / ab.dot_product(ab), 0.0, 1.0);
+            Vector d = p - (a + Vector(ab.x * t, ab.y * t));
+            nearest = std::min(nearest, std::sqrt(d.dot_product(d)));
+        }
+        EXPECT_LE(nearest, 1e-3 + 1e-12);
+    }
+}
+
+/**
+ * @brief Tests that a polygon rejected for its collinear vertices is 
+ *        accepted after the simplification, with the same axes.
+ */
+TEST(VertexSimplifierTest, ConvexPolygonInput)
+{
+    std::vector<Point> points = {
+        Point(0, 0),
+        Point(1, 0),
+        Point(2, 0),
+        Point(2, 2),
+        Point(0, 2),
+    };
+
+    EXPECT_THROW(
+        ConvexPolygon(points.begin(), points.end()),
+        std::invalid_argument);
+
+    ConvexPolygon polygon(points.begin(), points.end(), VertexSimplifier());
+    EXPECT_EQ(polygon.end() - polygon.begin(), 4);
+    EXPECT_EQ(polygon.find_axes_of_symmetry().size(), 4);
+}
+
+/**
+ * @brief Tests that a simplification with a tolerance keeps the axes of 
+ *        the outline: an egg keeps its single axis while losing most 
+ *        vertices, and a regular polygon, none of whose reductions keeps 
+ *        every axis, is not reduced.
+ */
+TEST(VertexSimplifierTest, ToleranceKeepsAxes)
+{
+    std::vector<Point> egg = sampledOutline(1000, [](double angle)
+    {
+        const double radius = 1 + 0.2 * std::cos(angle);
+        return Point(radius * std::cos(angle), radius * std::sin(angle));
+    });
+    std::vector<Point> circle = sampledOutline(1000, [](double angle)
+    {
+        return Point(std::cos(angle), std::sin(angle));
+    });
+
+    VertexSimplifier simplifier(1e-9, 1e-3);
+    EXPECT_FALSE(simplifier.is_exact());
+    EXPECT_TRUE(simplifier.exact().is_exact());
+
+    ConvexPolygon coarse(egg.begin(), egg.end(), simplifier);
+    ConvexPolygon original(egg.begin(), egg.end(), simplifier.exact());
+    EXPECT_LT(coarse.end() - coarse.begin(), 200);
+    EXPECT_EQ(original.end() - original.begin(), 1000);
+
+    auto axes = coarse.find_axes_of_symmetry(1e-6);
+    ASSERT_EQ(axes.size(), 1);
+    EXPECT_EQ(original.verify_axes(axes, 1e-6), std::vector<bool>{true});
+    EXPECT_NEAR(axes[0].direction.y, 0, 1e-9);
+    EXPECT_TRUE(coarse.has_symmetry(original, 1e-6));
+
+    ConvexPolygon regular(circle.begin(), circle.end(),
+                          VertexSimplifier(1e-9, 1e-4));
+    ConvexPolygon exact(circle.begin(), circle.end(), VertexSimplifier());
+    EXPECT_EQ(regular.end() - regular.begin(), 1000);
+    EXPECT_EQ(regular.find_axes_of_symmetry(
+        exact, std::pmr::get_default_resource(), 1e-6).size(), 1000);
+}
+
+/**
+ * @brief Tests that the original outline is searched when an axis of 
+ *        the simplified polygon does not hold for it.
+ */
+TEST(VertexSimplifierTest, BrokenAxesFallBackToOriginal)
+{
+    std::vector<Point> square = {
+        Point(0, 0), Point(2, 0), Point(2, 2), Point(0, 2)};
+    std::vector<Point> rectangle = {
+        Point(0, 0), Point(2, 0), Point(2, 1), Point(0, 1)};
+    std::vector<Point> kite = {
+        Point(0, 0), Point(2, 1), Point(0, 3), Point(-2, 1)};
+
+    ConvexPolygon ps(square.begin(), square.end());
+    ConvexPolygon pr(rectangle.begin(), rectangle.end());
+    ConvexPolygon pk(kite.begin(), kite.end());
+    auto *resource = std::pmr::get_default_resource();
+
+    // The axes of the square only partly hold for the rectangle
+    auto axes = ps.find_axes_of_symmetry(pr, resource);
+    EXPECT_EQ(axes.size(), 2);
+    EXPECT_EQ(pr.verify_axes(axes), std::vector<bool>(2, true));
+
+    // None of them holds for the kite, whose own axis is found
+    axes = ps.find_axes_of_symmetry(pk, resource);
+    ASSERT_EQ(axes.size(), 1);
+    EXPECT_EQ(pk.verify_axes(axes), std::vector<bool>{true});
+    EXPECT_TRUE(ps.has_symmetry(pk));
+}
@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "WorkStealingPool.h"
+
+/**
+ * @brief Tests that wait() returns after all tasks, including the 
+ *        tasks submitted by other tasks, have run.
+ */
+TEST(WorkStealingPoolTest, RunsNestedTasks)
+{
+    WorkStealingPool pool(4);
+    std::atomic<int> leaves{0};
+
+    std::function<void(int)> split = [&](int depth)
+    {
+        if (depth == 0)
+        {
+            leaves.fetch_add(1);
+            return;
+        }
+        pool.submit([&split, depth] { split(depth - 1); });
+        pool.submit([&split, depth] { split(depth - 1); });
+    };
+
+    pool.submit([&] { split(10); });
+    pool.wait();
+
+    EXPECT_EQ(leaves.load(), 1 << 10);
+}
+
+/**
+ * @brief Tests that the pool can be reused after waiting.
+ */
+TEST(WorkStealingPoolTest, ReusedAfterWait)
+{
+    WorkStealingPool pool(2);
+    std::atomic<int> count{0};
+
+    for (int round = 0; round < 3; ++round)
+    {
+        for (int i = 0; i < 100; ++i)
+            pool.submit([&] { count.fetch_add(1); });
+        pool.wait();
+        EXPECT_EQ(count.load(), 100 * (round + 1));
+    }
+}
+
+/**
+ * @brief Tests that the tasks a worker submits to its own deque are 
+ *        stolen by the other workers.
+ */
+TEST(WorkStealingPoolTest, StealsTasks)
+{
+    WorkStealingPool pool(4);
+    std::mutex mutex;
+    std::thread::id owner;
+    std::vector<std::thread::id> runners;
+
+    pool.submit([&]
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            owner = std::this_thread::get_id();
+        }
+        for (int i = 0; i < 40; ++i)
+        {
+            pool.submit([&]
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                std::lock_guard<std::mutex> lock(mutex);
+                runners.push_back(std::this_thread::get_id());
+            });
+        }
+    });
+    pool.wait();
+
+    ASSERT_EQ(runners.size(), 40);
+    std::size_t stolen = 0;
+    for (const auto &runner : runners)
+        stolen += runner != owner;
+    EXPECT_GT(stolen, 0);
+}
@@ -1,5 +1,14 @@
 #include <gtest/gtest.h>
 
+#include <cstring>
+#include <string>
+
+/// Path of this executable, defined in ShardedRunner_tests.cpp.
+extern std::string test_executable;
+
+/// Runs a shard in a worker process, defined in ShardedRunner_tests.cpp.
+int run_shard_worker(int argc, char **argv);
+
 /**
  * @brief Main function for running all the tests.
  * @param argc Number of command line arguments.
@@ -8,6 +17,14 @@
  */
 int main(int argc, char **argv)
 {
+    // The ShardedRunner tests start this executable as their worker
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--shard-worker") == 0)
+            return run_shard_worker(argc, argv);
+    }
+
+    test_executable = argv[0];
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
 }
\ No newline at end of file